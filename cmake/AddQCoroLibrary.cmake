@@ -87,6 +87,7 @@ function(add_qcoro_library)
         ${target_name}
         ${target_include_interface} $<BUILD_INTERFACE:${QCORO_SOURCE_DIR}>
         ${target_include_interface} $<BUILD_INTERFACE:${QCORO_SOURCE_DIR}/qcoro>
+        ${target_include_interface} $<BUILD_INTERFACE:${QCORO_BINARY_DIR}>
         ${target_include_interface} $<BUILD_INTERFACE:${CMAKE_CURRENT_SOURCE_DIR}>
         ${target_include_interface} $<BUILD_INTERFACE:${CMAKE_CURRENT_BINARY_DIR}>
         ${target_include_interface} $<INSTALL_INTERFACE:${CMAKE_INSTALL_INCLUDEDIR}>
@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+ * Do NOT include this file directly - include the QCoroSignal header instead!
+ */
+
+#pragma once
+
+#include "qcorocore_export.h"
+
+#include <QObject>
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace QCoro::detail {
+
+//! Per-thread receiver of signal connections made by signal awaiters.
+/*!
+ * Rather than creating a QObject to receive the queued signal for every single `co_await`,
+ * all awaiters in a thread connect the signal to the thread's SignalContext.
+ *
+ * Since the receiver outlives the awaiters, an invocation of the connected functor that has
+ * already been queued when the awaiter is destroyed would still be delivered. The functor thus
+ * doesn't capture the awaiter itself, but a generation-checked Handle of a slot that points
+ * to the awaiter and that's released when the awaiter disconnects.
+ *
+ * attach(), retarget() and detach() must be called from the context's thread. claim() is
+ * called by directly connected signals emitted in any thread and target() by invocations queued
+ * from any thread, so all access to the slots is guarded by a mutex.
+ */
+class QCOROCORE_EXPORT SignalContext final : public QObject {
+public:
+    //! Refers to an awaiter attached to the context.
+    struct Handle {
+        std::uint32_t index = 0;
+        //! Generation of the slot, 0 is an invalid handle.
+        std::uint32_t generation = 0;
+
+        bool isValid() const noexcept {
+            return generation != 0;
+        }
+    };
+
+    //! Returns the context of the current thread.
+    static SignalContext *current();
+
+    //! Attaches the \c target and returns a handle to it.
+    Handle attach(void *target) {
+        std::lock_guard lock(mMutex);
+        std::uint32_t index = 0;
+        if (mFreeSlot != noSlot) {
+            index = mFreeSlot;
+            mFreeSlot = mSlots[index].nextFree;
+        } else {
+            index = static_cast<std::uint32_t>(mSlots.size());
+            mSlots.push_back(Slot{});
+        }
+        auto &slot = mSlots[index];
+        slot.target = target;
+        return Handle{index, slot.generation};
+    }
+
+    //! Updates the target of the \c handle, used when the awaiter is moved.
+    void retarget(Handle handle, void *target) noexcept {
+        std::lock_guard lock(mMutex);
+        Q_ASSERT(targetLocked(handle) != nullptr);
+        mSlots[handle.index].target = target;
+    }
+
+    //! Releases the slot of the \c handle, the handle and all its copies become invalid.
+    /*!
+     * Returns \c false if the handle has already been detached or claimed.
+     */
+    bool detach(Handle handle) noexcept {
+        std::lock_guard lock(mMutex);
+        return release(handle) != nullptr;
+    }
+
+    //! Detaches the \c handle and invokes \c func with its target, unless it has been detached already.
+    /*!
+     * Can be called from any thread. The \c func is invoked while the context is locked, so the
+     * target can't be detached by its owner, and thus can't be destroyed, in the meantime. Returns
+     * whether \c func has been invoked.
+     */
+    template<typename Func>
+    bool claim(Handle handle, Func &&func) {
+        std::lock_guard lock(mMutex);
+        if (auto *target = release(handle); target != nullptr) {
+            func(target);
+            return true;
+        }
+        return false;
+    }
+
+    //! Returns the target of the \c handle, or \c nullptr if it has been detached.
+    /*!
+     * Can be called from any thread. The returned target is only guaranteed to stay alive when
+     * called from the context's thread, where its owner detaches it.
+     */
+    void *target(Handle handle) const noexcept {
+        std::lock_guard lock(mMutex);
+        return targetLocked(handle);
+    }
+
+private:
+    SignalContext() = default;
+
+    //! Same as target(), but the context must already be locked.
+    void *targetLocked(Handle handle) const noexcept {
+        if (!handle.isValid() || handle.index >= mSlots.size()) {
+            return nullptr;
+        }
+        const auto &slot = mSlots[handle.index];
+        return slot.generation == handle.generation ? slot.target : nullptr;
+    }
+
+    static constexpr std::uint32_t noSlot = UINT32_MAX;
+
+    struct Slot {
+        void *target = nullptr;
+        std::uint32_t generation = 1;
+        std::uint32_t nextFree = noSlot;
+    };
+
+    void *release(Handle handle) noexcept {
+        auto *target = targetLocked(handle);
+        if (target == nullptr) {
+            return nullptr;
+        }
+        auto &slot = mSlots[handle.index];
+        slot.target = nullptr;
+        if (++slot.generation == 0) {
+            slot.generation = 1;
+        }
+        slot.nextFree = mFreeSlot;
+        mFreeSlot = handle.index;
+        return target;
+    }
+
+    mutable std::mutex mMutex;
+    std::vector<Slot> mSlots;
+    std::uint32_t mFreeSlot = noSlot;
+};
+
+} // namespace QCoro::detail
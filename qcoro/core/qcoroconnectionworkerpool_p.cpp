@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcoroconnectionworkerpool_p.h"
+
+#include <QObject>
+#include <QScopeGuard>
+#include <QThread>
+
+#include <algorithm>
+#include <thread>
+
+using namespace QCoro::detail;
+
+//! A worker thread running an event loop, with a context object living in the thread.
+struct ConnectionWorkerPool::Worker {
+    QThread thread;
+    //! Parent of the connections served by the worker, used to invoke code in the worker thread.
+    std::unique_ptr<QObject> context = std::make_unique<QObject>();
+    //! Number of connections being served, only accessed from the worker thread.
+    int activeConnections = 0;
+    //! Whether the pool is being destroyed, only accessed from the worker thread.
+    bool stopping = false;
+};
+
+ConnectionWorkerPool::ConnectionWorkerPool(const QString &name, int workerCount, Close close)
+    : mClose(std::move(close))
+{
+    if (workerCount <= 0) {
+        workerCount = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    }
+    mWorkers.reserve(static_cast<std::size_t>(workerCount));
+    for (int i = 0; i < workerCount; ++i) {
+        auto &worker = mWorkers.emplace_back(std::make_unique<Worker>());
+        worker->thread.setObjectName(QStringLiteral("%1 worker %2").arg(name).arg(i));
+        worker->context->moveToThread(&worker->thread);
+        worker->thread.start();
+    }
+}
+
+ConnectionWorkerPool::~ConnectionWorkerPool() {
+    for (auto &worker : mWorkers) {
+        // Queued after all pending dispatches to the worker, so their connections are closed as well.
+        // The worker keeps running its event loop until the coroutines serving the closed connections
+        // finish, and only then quits.
+        QMetaObject::invokeMethod(worker->context.get(), [worker = worker.get(), this]() {
+            worker->stopping = true;
+            const auto connections = worker->context->findChildren<QObject *>(Qt::FindDirectChildrenOnly);
+            for (auto *connection : connections) {
+                mClose(connection);
+            }
+            if (worker->activeConnections == 0) {
+                worker->thread.quit();
+            }
+        }, Qt::QueuedConnection);
+    }
+    for (auto &worker : mWorkers) {
+        worker->thread.wait();
+    }
+}
+
+int ConnectionWorkerPool::workerCount() const {
+    return static_cast<int>(mWorkers.size());
+}
+
+void ConnectionWorkerPool::dispatch(Serve serve) {
+    auto &worker = nextWorker();
+    QMetaObject::invokeMethod(worker.context.get(), [&worker, serve = std::move(serve)]() mutable {
+        serveConnection(worker, std::move(serve));
+    }, Qt::QueuedConnection);
+}
+
+void ConnectionWorkerPool::dispatch(QObject *connection, Serve serve) {
+    Q_ASSERT(connection->thread() == QThread::currentThread());
+
+    auto &worker = nextWorker();
+    // An object with a parent cannot be moved to another thread, the connection is reparented
+    // to the worker's context once it lives in the worker thread. This happens in the same queued
+    // call that serves it, so the connection is owned by the worker before the pool can close it.
+    connection->setParent(nullptr);
+    connection->moveToThread(&worker.thread);
+    QMetaObject::invokeMethod(worker.context.get(), [&worker, connection, serve = std::move(serve)]() mutable {
+        connection->setParent(worker.context.get());
+        serveConnection(worker, std::move(serve));
+    }, Qt::QueuedConnection);
+}
+
+ConnectionWorkerPool::Worker &ConnectionWorkerPool::nextWorker() {
+    auto &worker = *mWorkers[mNextWorker];
+    mNextWorker = (mNextWorker + 1) % mWorkers.size();
+    return worker;
+}
+
+QCoro::Task<> ConnectionWorkerPool::serveConnection(Worker &worker, Serve serve) {
+    ++worker.activeConnections;
+    const auto finished = qScopeGuard([&worker]() {
+        if (--worker.activeConnections == 0 && worker.stopping) {
+            worker.thread.quit();
+        }
+    });
+    co_await serve(worker.context.get());
+}
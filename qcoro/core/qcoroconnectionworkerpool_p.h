@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorocore_export.h"
+#include "qcorotask.h"
+
+#include <QString>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class QObject;
+
+namespace QCoro::detail {
+
+//! Serves connections with coroutines on a pool of worker threads, each running an event loop.
+/*!
+ * Shared by ThreadedTcpServer and WebSocketWorkerPool. Each connection is served by the next
+ * worker, in a round-robin fashion. The object representing a connection must be a child of
+ * the worker's context object while it's being served, so that the pool can close it when
+ * the pool is destroyed.
+ */
+class QCOROCORE_EXPORT ConnectionWorkerPool {
+public:
+    //! Coroutine serving a connection, called in the worker thread with the worker's context object.
+    using Serve = std::function<Task<>(QObject *context)>;
+    //! Closes the connection, so that the coroutine serving it finishes.
+    using Close = std::function<void(QObject *connection)>;
+
+    //! Starts \c workerCount workers named after \c name, or one worker per CPU core if \c workerCount is 0.
+    ConnectionWorkerPool(const QString &name, int workerCount, Close close);
+
+    //! Closes the open connections, waits for their coroutines to finish and stops the workers.
+    /*!
+     * Connections dispatched before the pool is destroyed are served and closed as well.
+     */
+    ~ConnectionWorkerPool();
+    ConnectionWorkerPool(const ConnectionWorkerPool &) = delete;
+    ConnectionWorkerPool &operator=(const ConnectionWorkerPool &) = delete;
+
+    //! Returns the number of worker threads.
+    int workerCount() const;
+
+    //! Serves a new connection on the next worker.
+    void dispatch(Serve serve);
+
+    //! Moves the \c connection to the next worker and serves it there.
+    /*!
+     * Must be called from the thread the \c connection lives in. The \c connection is
+     * reparented to the worker's context object before it's served.
+     */
+    void dispatch(QObject *connection, Serve serve);
+
+private:
+    struct Worker;
+
+    Worker &nextWorker();
+    static Task<> serveConnection(Worker &worker, Serve serve);
+
+    const Close mClose;
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::size_t mNextWorker = 0;
+};
+
+} // namespace QCoro::detail
@@ -2,6 +2,7 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include "qcoroframedstream.h"
 #include "qcoroiodevice.h"
 #include "qcoroprocess.h"
 #include "qcorosignal.h"
@@ -0,0 +1,296 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcoroframedstream.h"
+#include "qcoroiodevice.h"
+#include "qcoroiodevice_p.h"
+
+#include <QIODevice>
+#include <QObject>
+#include <QPointer>
+#include <QtEndian>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+using namespace QCoro;
+using namespace QCoro::detail;
+
+namespace {
+
+using LengthPrefix = FramedStream::LengthPrefix;
+
+//! The longest length prefix, a varint of a 64-bit length.
+constexpr int maxVarintSize = 10;
+//! Frames smaller than this are copied into the batch, larger frames are passed to the device as they are.
+constexpr qint64 maxBatchedFrameSize = 4 * 1024;
+//! The batch is written right away once it reaches this size.
+constexpr qint64 maxBatchSize = 64 * 1024;
+//! sendFrame() waits once more data than this are waiting in the device's write buffer.
+constexpr qint64 highWaterMark = QCoroIODevice::defaultHighWaterMark;
+
+int maxPrefixSize(LengthPrefix lengthPrefix) {
+    switch (lengthPrefix) {
+    case LengthPrefix::UInt16:
+        return sizeof(quint16);
+    case LengthPrefix::UInt32:
+        return sizeof(quint32);
+    case LengthPrefix::UInt64:
+        return sizeof(quint64);
+    case LengthPrefix::Varint:
+        return maxVarintSize;
+    }
+    Q_UNREACHABLE();
+    return 0;
+}
+
+//! Returns the longest frame whose length the \c lengthPrefix can encode.
+qint64 maxEncodableLength(LengthPrefix lengthPrefix) {
+    switch (lengthPrefix) {
+    case LengthPrefix::UInt16:
+        return std::numeric_limits<quint16>::max();
+    case LengthPrefix::UInt32:
+        return std::numeric_limits<quint32>::max();
+    case LengthPrefix::UInt64:
+    case LengthPrefix::Varint:
+        return std::numeric_limits<qint64>::max();
+    }
+    Q_UNREACHABLE();
+    return 0;
+}
+
+//! Encodes the \c length into \c out, returns the size of the prefix.
+int encodePrefix(LengthPrefix lengthPrefix, quint64 length, char *out) {
+    switch (lengthPrefix) {
+    case LengthPrefix::UInt16:
+        qToBigEndian(static_cast<quint16>(length), out);
+        return sizeof(quint16);
+    case LengthPrefix::UInt32:
+        qToBigEndian(static_cast<quint32>(length), out);
+        return sizeof(quint32);
+    case LengthPrefix::UInt64:
+        qToBigEndian(static_cast<quint64>(length), out);
+        return sizeof(quint64);
+    case LengthPrefix::Varint: {
+        int size = 0;
+        do {
+            auto byte = static_cast<quint8>(length & 0x7f);
+            length >>= 7;
+            if (length != 0) {
+                byte |= 0x80;
+            }
+            out[size++] = static_cast<char>(byte);
+        } while (length != 0);
+        return size;
+    }
+    }
+    Q_UNREACHABLE();
+    return 0;
+}
+
+enum class DecodeResult {
+    Incomplete,
+    Complete,
+    Malformed,
+};
+
+//! Decodes the length prefix at the beginning of the \c data, sets the \c length and \c size of the prefix.
+DecodeResult decodePrefix(LengthPrefix lengthPrefix, const char *data, qint64 available, quint64 &length, int &size) {
+    if (lengthPrefix != LengthPrefix::Varint) {
+        size = maxPrefixSize(lengthPrefix);
+        if (available < size) {
+            return DecodeResult::Incomplete;
+        }
+        switch (lengthPrefix) {
+        case LengthPrefix::UInt16:
+            length = qFromBigEndian<quint16>(data);
+            break;
+        case LengthPrefix::UInt32:
+            length = qFromBigEndian<quint32>(data);
+            break;
+        default:
+            length = qFromBigEndian<quint64>(data);
+            break;
+        }
+        return DecodeResult::Complete;
+    }
+
+    length = 0;
+    for (int i = 0; i < maxVarintSize; ++i) {
+        if (i >= available) {
+            return DecodeResult::Incomplete;
+        }
+        const auto byte = static_cast<quint8>(data[i]);
+        // The last byte can only carry the single remaining bit of a 64-bit length
+        if (i == maxVarintSize - 1 && byte > 1) {
+            return DecodeResult::Malformed;
+        }
+        length |= static_cast<quint64>(byte & 0x7f) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            size = i + 1;
+            return DecodeResult::Complete;
+        }
+    }
+    return DecodeResult::Malformed;
+}
+
+} // namespace
+
+namespace QCoro::detail {
+
+class FramedStreamPrivate {
+public:
+    FramedStreamPrivate(QIODevice *device, LengthPrefix lengthPrefix, qint64 maxFrameSize)
+        : mDevice(device)
+        // A socket may still be open with buffered data after it has disconnected
+        , mNotifier(device, isReadChannelFinished(device))
+        , mLengthPrefix(lengthPrefix)
+        // A longer frame would have its length truncated in the prefix
+        , mMaxFrameSize(std::min(maxFrameSize, maxEncodableLength(lengthPrefix)))
+    {
+        // With Qt 5 clearing the batch only keeps its buffer when the capacity has been reserved
+        mBatch.reserve(maxBatchedFrameSize);
+    }
+
+    QPointer<QIODevice> mDevice;
+    IODeviceReadNotifier mNotifier;
+    const LengthPrefix mLengthPrefix;
+    const qint64 mMaxFrameSize;
+    FramedStream::Error mError = FramedStream::Error::NoError;
+
+    //! Encoded frames waiting to be written to the device.
+    QByteArray mBatch;
+    //! Receives the queued flush of the batch, which is dropped when the stream is destroyed, as the destructor flushes.
+    QObject mFlushContext;
+    bool mFlushScheduled = false;
+};
+
+} // namespace QCoro::detail
+
+FramedStream::FramedStream(QIODevice *device, LengthPrefix lengthPrefix, qint64 maxFrameSize)
+    : d(std::make_unique<FramedStreamPrivate>(device, lengthPrefix, maxFrameSize))
+{}
+
+FramedStream::~FramedStream() {
+    // The frames have already been reported as sent
+    flush();
+}
+
+QIODevice *FramedStream::device() const {
+    return d->mDevice;
+}
+
+FramedStream::LengthPrefix FramedStream::lengthPrefix() const {
+    return d->mLengthPrefix;
+}
+
+qint64 FramedStream::maxFrameSize() const {
+    return d->mMaxFrameSize;
+}
+
+FramedStream::Error FramedStream::error() const {
+    return d->mError;
+}
+
+AsyncGenerator<QByteArray> FramedStream::frames(std::chrono::milliseconds timeout) {
+    d->mError = Error::NoError;
+    auto &device = d->mDevice;
+    auto &notifier = d->mNotifier;
+    std::array<char, maxVarintSize> prefix;
+    while (device && device->isReadable()) {
+        const auto peeked = device->peek(prefix.data(), maxPrefixSize(d->mLengthPrefix));
+        quint64 length = 0;
+        int prefixSize = 0;
+        const auto result = peeked > 0 ? decodePrefix(d->mLengthPrefix, prefix.data(), peeked, length, prefixSize)
+                                       : DecodeResult::Incomplete;
+        if (result == DecodeResult::Malformed) {
+            d->mError = Error::MalformedLengthPrefix;
+            co_return;
+        }
+        if (result == DecodeResult::Incomplete) {
+            if (notifier.isAtEnd() || !co_await notifier.wait(timeout)) {
+                if (peeked > 0) {
+                    d->mError = Error::TruncatedFrame;
+                }
+                co_return;
+            }
+            continue;
+        }
+        if (length > static_cast<quint64>(d->mMaxFrameSize)) {
+            d->mError = Error::FrameTooLarge;
+            co_return;
+        }
+
+        device->skip(prefixSize);
+        // The payload is read right into the frame, however many readyRead() signals it takes
+        const auto frameSize = static_cast<qint64>(length);
+        QByteArray frame(frameSize, Qt::Uninitialized);
+        qint64 bytesRead = 0;
+        while (bytesRead < frameSize && device) {
+            const auto chunkSize = device->read(frame.data() + bytesRead, frameSize - bytesRead);
+            if (chunkSize < 0) {
+                break;
+            }
+            bytesRead += chunkSize;
+            if (bytesRead < frameSize && (notifier.isAtEnd() || !co_await notifier.wait(timeout))) {
+                break;
+            }
+        }
+        if (bytesRead < frameSize) {
+            d->mError = Error::TruncatedFrame;
+            co_return;
+        }
+
+        co_yield frame;
+    }
+}
+
+Task<bool> FramedStream::sendFrame(const QByteArray &frame) {
+    if (!d->mDevice || !d->mDevice->isWritable() || frame.size() > d->mMaxFrameSize) {
+        co_return false;
+    }
+
+    std::array<char, maxVarintSize> prefix;
+    const auto prefixSize = encodePrefix(d->mLengthPrefix, static_cast<quint64>(frame.size()), prefix.data());
+    d->mBatch.append(prefix.data(), prefixSize);
+    bool ok = true;
+    if (frame.size() > maxBatchedFrameSize) {
+        // Copying a large frame into the batch would cost more than writing it separately
+        ok = flush() && d->mDevice->write(frame) == frame.size();
+    } else {
+        d->mBatch.append(frame);
+        if (d->mBatch.size() >= maxBatchSize) {
+            ok = flush();
+        } else {
+            scheduleFlush();
+        }
+    }
+
+    while (ok && d->mDevice && d->mDevice->bytesToWrite() >= highWaterMark) {
+        ok = (co_await qCoro(d->mDevice.data()).waitForBytesWritten(-1)).has_value();
+    }
+    co_return ok && d->mDevice;
+}
+
+bool FramedStream::flush() {
+    d->mFlushScheduled = false;
+    if (d->mBatch.isEmpty()) {
+        return true;
+    }
+
+    const qint64 size = d->mBatch.size();
+    // Copied by the device rather than shared, so that the batch keeps its buffer for the next frames
+    const auto written = d->mDevice && d->mDevice->isWritable() ? d->mDevice->write(d->mBatch.constData(), size) : -1;
+    d->mBatch.resize(0);
+    return written == size;
+}
+
+void FramedStream::scheduleFlush() {
+    if (d->mFlushScheduled) {
+        return;
+    }
+    d->mFlushScheduled = true;
+    QMetaObject::invokeMethod(&d->mFlushContext, [this]() { flush(); }, Qt::QueuedConnection);
+}
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorocore_export.h"
+#include "qcoro/qcoroasyncgenerator.h"
+#include "qcoro/qcorotask.h"
+
+#include <QByteArray>
+
+#include <chrono>
+#include <memory>
+
+class QIODevice;
+
+namespace QCoro {
+
+namespace detail {
+class FramedStreamPrivate;
+} // namespace detail
+
+//! Exchanges length-prefixed messages (frames) over a QIODevice.
+/*!
+ * Each frame is preceded by its length, encoded either as a fixed-width big-endian unsigned
+ * integer or as a varint. Received frames are produced by the frames() generator, frames are
+ * sent with sendFrame().
+ *
+ * ```cpp
+ * QCoro::FramedStream stream(socket, QCoro::FramedStream::LengthPrefix::Varint);
+ * QCORO_FOREACH(const QByteArray &request, stream.frames()) {
+ *     co_await stream.sendFrame(handleRequest(request));
+ * }
+ * ```
+ *
+ * The stream must outlive the generator returned by frames() and all pending sendFrame() calls.
+ */
+class QCOROCORE_EXPORT FramedStream {
+public:
+    //! Encoding of the length that precedes each frame.
+    enum class LengthPrefix {
+        UInt16, //!< 16-bit unsigned integer in big-endian byte order.
+        UInt32, //!< 32-bit unsigned integer in big-endian byte order.
+        UInt64, //!< 64-bit unsigned integer in big-endian byte order.
+        Varint, //!< Unsigned LEB128 varint, as used by Protocol Buffers.
+    };
+
+    //! Reason why the frames() generator has stopped.
+    enum class Error {
+        NoError,               //!< No error, the device has ended, was closed or has timed out between frames.
+        FrameTooLarge,         //!< The length of the received frame exceeds maxFrameSize().
+        MalformedLengthPrefix, //!< The received varint length prefix is longer than 64 bits.
+        TruncatedFrame,        //!< The device has ended, was closed or has timed out in the middle of a frame.
+    };
+
+    //! Default limit of the frame size.
+    static constexpr qint64 defaultMaxFrameSize = 16 * 1024 * 1024;
+
+    //! Creates a stream over the \c device.
+    /*!
+     * Frames longer than \c maxFrameSize are neither received nor sent. The limit is lowered
+     * to the longest length the \c lengthPrefix can encode, e.g. 65535 bytes for UInt16.
+     */
+    explicit FramedStream(QIODevice *device, LengthPrefix lengthPrefix = LengthPrefix::UInt32,
+                          qint64 maxFrameSize = defaultMaxFrameSize);
+    //! Writes the frames that are still batched to the device, see flush().
+    ~FramedStream();
+    FramedStream(const FramedStream &) = delete;
+    FramedStream &operator=(const FramedStream &) = delete;
+    FramedStream(FramedStream &&) = delete;
+    FramedStream &operator=(FramedStream &&) = delete;
+
+    //! Returns the device the frames are exchanged over.
+    QIODevice *device() const;
+
+    //! Returns the encoding of the length prefix.
+    LengthPrefix lengthPrefix() const;
+
+    //! Returns the limit of the frame size.
+    qint64 maxFrameSize() const;
+
+    //! Returns why the last frames() generator has stopped.
+    Error error() const;
+
+    //! Returns a generator that yields the frames received from the device.
+    /*!
+     * The payload of each frame is read from the device directly into the yielded QByteArray,
+     * even if it arrives over many `readyRead()` signals. No data past the frame are consumed.
+     *
+     * The generator ends when the device is closed, when no more data will arrive or when no
+     * new data arrive within the \c timeout. It also ends when a malformed or too large frame
+     * is received, since the stream can't be recovered anymore. Check error() to find out why
+     * the generator has ended. If the \c timeout is -1, the generator never times out.
+     *
+     * Only a single generator may be consuming the frames at a time.
+     */
+    AsyncGenerator<QByteArray> frames(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+    //! Sends the \c frame.
+    /*!
+     * Small frames are appended into a batch that's written to the device with a single write,
+     * once control returns to the event loop, so sending many small frames in a row doesn't
+     * write to the device for each of them. Larger frames are passed to the device as they
+     * are, right after the frames batched before them.
+     *
+     * The returned task completes right away, unless the data waiting in the device's write
+     * buffer exceed the high-water mark, in which case it waits for the device to write them.
+     * Returns \c false if the frame exceeds maxFrameSize() or if writing to the device fails.
+     */
+    Task<bool> sendFrame(const QByteArray &frame);
+
+    //! Writes the frames batched by sendFrame() to the device right away.
+    /*!
+     * Call it before disconnecting or closing the device, so that the batched frames are
+     * written before the device stops accepting data. Returns \c false if writing to the
+     * device fails.
+     */
+    bool flush();
+
+private:
+    void scheduleFlush();
+
+    std::unique_ptr<detail::FramedStreamPrivate> d;
+};
+
+} // namespace QCoro
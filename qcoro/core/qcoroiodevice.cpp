@@ -7,11 +7,212 @@
 #include "qcorosignal.h"
 
 #include <QByteArray>
+#include <QFileDevice>
 #include <QIODevice>
-#include <QTimer>
+#include <QPointer>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
 
 using namespace QCoro::detail;
 
+namespace {
+
+//! Buffers into which QCoroIODevice::chunks() reads the data.
+/*!
+ * A buffer is reused for the next chunk once the consumer no longer holds a copy of it, so
+ * as long as the consumer only looks at each chunk, reading the device doesn't allocate.
+ */
+class ChunkBufferPool {
+public:
+    ChunkBufferPool() {
+        // The consumer may still hold a reference to a buffer when the next one is added
+        mBuffers.reserve(maxBuffers);
+    }
+
+    QByteArray &acquire(qint64 size) {
+        for (auto &buffer : mBuffers) {
+            // Null when the consumer has moved the buffer away
+            if (buffer.isNull() || buffer.isDetached()) {
+                buffer.resize(size);
+                return buffer;
+            }
+        }
+
+        if (mBuffers.size() < maxBuffers) {
+            return mBuffers.emplace_back(size, Qt::Uninitialized);
+        }
+
+        // The consumer holds on to all the buffers, leave the oldest one to it.
+        auto &buffer = mBuffers[mNextReplaced];
+        mNextReplaced = (mNextReplaced + 1) % maxBuffers;
+        buffer = QByteArray(size, Qt::Uninitialized);
+        return buffer;
+    }
+
+private:
+    static constexpr std::size_t maxBuffers = 4;
+    std::vector<QByteArray> mBuffers;
+    std::size_t mNextReplaced = 0;
+};
+
+QCoro::AsyncGenerator<QByteArray> readChunks(QPointer<QIODevice> device,
+                                             std::shared_ptr<IODeviceReadNotifier> notifier,
+                                             qint64 chunkSize, std::chrono::milliseconds timeout) {
+    ChunkBufferPool pool;
+    while (device && device->isOpen() && device->isReadable()) {
+        const auto available = device->bytesAvailable();
+        if (available <= 0) {
+            if (notifier->isAtEnd() || !co_await notifier->wait(timeout)) {
+                break;
+            }
+            continue;
+        }
+
+        auto &buffer = pool.acquire(std::min(available, chunkSize));
+        const auto bytesRead = device->read(buffer.data(), buffer.size());
+        if (bytesRead <= 0) {
+            break;
+        }
+        buffer.resize(bytesRead);
+        co_yield buffer;
+    }
+}
+
+//! Passes on the chunks produced by the \c source, adding up their sizes in \c count.
+QCoro::AsyncGenerator<QByteArray> countBytes(QCoro::AsyncGenerator<QByteArray> source, qint64 &count) {
+    QCORO_FOREACH(QByteArray &chunk, source) {
+        count += chunk.size();
+        co_yield chunk;
+    }
+}
+
+//! Returns the offset of the first occurrence of the \c delimiter in the \c data, or -1.
+/*!
+ * Candidates are located with memchr(), which the C library implements with vector instructions,
+ * so the data are scanned many bytes at a time and only the candidates are compared byte by byte.
+ */
+qint64 findDelimiter(const char *data, qint64 size, const QByteArray &delimiter) {
+    const qint64 delimiterSize = delimiter.size();
+    const char *const end = data + size;
+    const char *pos = data;
+    while (end - pos >= delimiterSize) {
+        pos = static_cast<const char *>(std::memchr(pos, delimiter.at(0), static_cast<std::size_t>(end - pos - delimiterSize + 1)));
+        if (pos == nullptr) {
+            return -1;
+        }
+        if (std::memcmp(pos + 1, delimiter.constData() + 1, static_cast<std::size_t>(delimiterSize - 1)) == 0) {
+            return pos - data;
+        }
+        ++pos;
+    }
+    return -1;
+}
+
+//! Accumulates data from a device into a single buffer until a delimiter is found.
+/*!
+ * The data are peeked from the device right into the buffer and only the data up to and including
+ * the delimiter are then skipped in the device, so nothing past the delimiter is consumed. Data
+ * accumulated over several readyRead() signals are not scanned for the delimiter again.
+ */
+class DelimitedReader {
+public:
+    DelimitedReader(QByteArray delimiter, qint64 maxSize)
+        : mDelimiter(std::move(delimiter))
+        , mMaxSize(maxSize)
+    {
+        Q_ASSERT(!mDelimiter.isEmpty());
+    }
+
+    //! Moves the available data from the \c device into the buffer.
+    /*!
+     * Returns \c true once the delimiter has been found or the buffer has reached the maximum
+     * size, the data are then ready to be taken.
+     */
+    bool readFrom(QIODevice *device) {
+        while (true) {
+            const auto available = device->bytesAvailable();
+            if (available <= 0) {
+                return false;
+            }
+
+            // Peeking data past the delimiter is wasted, so start small and only grow the window
+            // with the buffer, keeping long searches linear.
+            const qint64 offset = mBuffer.size();
+            auto window = std::min(available, std::max(offset, minimumWindow));
+            if (mMaxSize > 0) {
+                window = std::min(window, mMaxSize - offset);
+            }
+            mBuffer.resize(offset + window);
+            const auto peeked = device->peek(mBuffer.data() + offset, window);
+            if (peeked <= 0) {
+                mBuffer.resize(offset);
+                return false;
+            }
+            mBuffer.resize(offset + peeked);
+
+            // The tail of the data scanned before may hold the beginning of the delimiter
+            const auto from = std::max<qint64>(offset - mDelimiter.size() + 1, 0);
+            const auto found = findDelimiter(mBuffer.constData() + from, mBuffer.size() - from, mDelimiter);
+            if (found >= 0) {
+                const auto end = from + found + mDelimiter.size();
+                device->skip(end - offset);
+                mBuffer.resize(end);
+                return true;
+            }
+
+            device->skip(peeked);
+            if (mMaxSize > 0 && mBuffer.size() >= mMaxSize) {
+                return true;
+            }
+        }
+    }
+
+    bool isEmpty() const {
+        return mBuffer.isEmpty();
+    }
+
+    //! Returns the accumulated data and starts accumulating anew.
+    QByteArray take() {
+        return std::exchange(mBuffer, QByteArray{});
+    }
+
+private:
+    static constexpr qint64 minimumWindow = 128;
+
+    QByteArray mDelimiter;
+    qint64 mMaxSize;
+    QByteArray mBuffer;
+};
+
+QCoro::AsyncGenerator<QByteArray> readLines(QPointer<QIODevice> device,
+                                            std::unique_ptr<IODeviceReadNotifier> notifier,
+                                            qint64 maxLineSize, std::chrono::milliseconds timeout) {
+    DelimitedReader reader(QByteArray(1, '\n'), maxLineSize);
+    while (device && device->isReadable()) {
+        if (reader.readFrom(device)) {
+            co_yield reader.take();
+            continue;
+        }
+        if (notifier->isAtEnd() || !co_await notifier->wait(timeout)) {
+            break;
+        }
+    }
+
+    // The last line doesn't have to be terminated
+    if (!reader.isEmpty()) {
+        co_yield reader.take();
+    }
+}
+
+} // namespace
+
 QCoroIODevice::OperationBase::OperationBase(QIODevice *device)
     : mDevice(device)
 {}
@@ -20,7 +221,8 @@ void QCoroIODevice::OperationBase::finish(std::coroutine_handle<> awaitingCorout
     QObject::disconnect(mConn);
     QObject::disconnect(mCloseConn);
     // Delayed trigger
-    QTimer::singleShot(0, [awaitingCoroutine]() mutable { awaitingCoroutine.resume(); });
+    mResumeNode.coroutine = awaitingCoroutine;
+    QCoro::ThreadExecutor::current().post(mResumeNode);
 }
 
 QCoroIODevice::ReadOperation::ReadOperation(QIODevice *device, std::function<QByteArray(QIODevice *)> &&resultCb)
@@ -50,6 +252,43 @@ QCoroIODevice::ReadAllOperation::ReadAllOperation(QIODevice *device)
 QCoroIODevice::ReadAllOperation::ReadAllOperation(QIODevice &device)
     : ReadAllOperation(&device) {}
 
+namespace {
+
+struct ReadChannelFinishedChecks {
+    std::mutex mutex;
+    std::vector<std::pair<const QMetaObject *, ReadChannelFinishedCheck>> checks;
+};
+
+ReadChannelFinishedChecks &readChannelFinishedChecks() {
+    // Intentionally leaked, the checks may still be used during static destruction.
+    static auto *checks = new ReadChannelFinishedChecks;
+    return *checks;
+}
+
+} // namespace
+
+void QCoro::detail::registerReadChannelFinishedCheck(const QMetaObject *metaObject, ReadChannelFinishedCheck check) {
+    auto &registry = readChannelFinishedChecks();
+    std::lock_guard lock(registry.mutex);
+    registry.checks.emplace_back(metaObject, check);
+}
+
+bool QCoro::detail::isReadChannelFinished(const QIODevice *device) {
+    if (!device) {
+        return true;
+    }
+    {
+        auto &registry = readChannelFinishedChecks();
+        std::lock_guard lock(registry.mutex);
+        for (const auto &[metaObject, check] : registry.checks) {
+            if (device->metaObject()->inherits(metaObject)) {
+                return check(device);
+            }
+        }
+    }
+    return !device->isOpen() || !device->isReadable();
+}
+
 QCoroIODevice::QCoroIODevice(QIODevice *device)
     : mDevice{device}
 {}
@@ -81,6 +320,65 @@ QCoro::Task<QByteArray> QCoroIODevice::readLine(qint64 maxSize, std::chrono::mil
     co_return device->readLine(maxSize);
 }
 
+QCoro::Task<QByteArray> QCoroIODevice::readExactly(qint64 size, std::chrono::milliseconds timeout) {
+    const auto device = mDevice;
+    if (size <= 0) {
+        co_return QByteArray{};
+    }
+
+    // The data are read right into the result, however many readyRead() signals it takes
+    QByteArray result(size, Qt::Uninitialized);
+    qint64 bytesRead = 0;
+    std::optional<IODeviceReadNotifier> notifier;
+    while (bytesRead < size && device && device->isReadable()) {
+        const auto chunkSize = device->read(result.data() + bytesRead, size - bytesRead);
+        if (chunkSize < 0) {
+            break;
+        }
+        bytesRead += chunkSize;
+        if (bytesRead == size) {
+            break;
+        }
+
+        if (!notifier) {
+            // Still before the first suspension, so the wrapper is alive
+            notifier.emplace(device, isReadChannelFinished());
+        }
+        if (notifier->isAtEnd() || !co_await notifier->wait(timeout)) {
+            break;
+        }
+    }
+
+    result.resize(bytesRead);
+    co_return result;
+}
+
+QCoro::Task<QByteArray> QCoroIODevice::readUntil(const QByteArray &delimiter, qint64 maxSize,
+                                                 std::chrono::milliseconds timeout) {
+    const auto device = mDevice;
+    DelimitedReader reader(delimiter, maxSize);
+    std::optional<IODeviceReadNotifier> notifier;
+    while (device && device->isReadable() && !reader.readFrom(device)) {
+        if (!notifier) {
+            // Still before the first suspension, so the wrapper is alive
+            notifier.emplace(device, isReadChannelFinished());
+        }
+        if (notifier->isAtEnd() || !co_await notifier->wait(timeout)) {
+            break;
+        }
+    }
+
+    co_return reader.take();
+}
+
+QCoro::AsyncGenerator<QByteArray> QCoroIODevice::lines(qint64 maxLineSize, std::chrono::milliseconds timeout) {
+    std::unique_ptr<IODeviceReadNotifier> notifier;
+    if (mDevice) {
+        notifier = std::make_unique<IODeviceReadNotifier>(mDevice, isReadChannelFinished());
+    }
+    return readLines(mDevice, std::move(notifier), maxLineSize, timeout);
+}
+
 QCoro::Task<qint64> QCoroIODevice::write(const QByteArray &buffer) {
     const auto bytesWritten = mDevice->write(buffer);
     qint64 bytesConfirmed = 0;
@@ -97,6 +395,187 @@ QCoro::Task<qint64> QCoroIODevice::write(const QByteArray &buffer) {
     co_return bytesConfirmed;
 }
 
+QCoro::Task<qint64> QCoroIODevice::writeAll(std::span<const QByteArray> buffers, qint64 highWaterMark) {
+    Q_ASSERT(highWaterMark > 0);
+    qint64 bytesWritten = 0;
+    for (const auto &buffer : buffers) {
+        const auto written = co_await writeBuffer(buffer, highWaterMark);
+        bytesWritten += written;
+        if (written < buffer.size()) {
+            break;
+        }
+    }
+
+    const auto pending = co_await flushWriteBuffer();
+    co_return std::max<qint64>(bytesWritten - pending, 0);
+}
+
+QCoro::Task<qint64> QCoroIODevice::writeAll(QCoro::AsyncGenerator<QByteArray> source, qint64 highWaterMark) {
+    Q_ASSERT(highWaterMark > 0);
+    qint64 bytesWritten = 0;
+    // The next buffer is only requested once the device has room for it, so that the source
+    // doesn't run ahead of the device.
+    if (co_await waitForWriteSpace(highWaterMark)) {
+        auto it = co_await source.begin();
+        while (it != source.end()) {
+            const auto written = co_await writeBuffer(*it, highWaterMark);
+            bytesWritten += written;
+            if (written < (*it).size() || !co_await waitForWriteSpace(highWaterMark)) {
+                break;
+            }
+            co_await ++it;
+        }
+    }
+
+    const auto pending = co_await flushWriteBuffer();
+    co_return std::max<qint64>(bytesWritten - pending, 0);
+}
+
+QCoro::Task<QCoroIODevice::TransferResult> QCoroIODevice::uploadFrom(QIODevice *source, qint64 bufferSize,
+                                                                    std::chrono::milliseconds timeout) {
+    Q_ASSERT(bufferSize > 0);
+    // Shared with the generator reading the source, to tell afterwards whether it has ended or timed out
+    std::shared_ptr<IODeviceReadNotifier> notifier;
+    if (source) {
+        notifier = std::make_shared<IODeviceReadNotifier>(source, detail::isReadChannelFinished(source));
+    }
+    auto result = co_await transfer(readChunks(source, notifier, bufferSize, timeout), mDevice, bufferSize);
+    result.complete = result.complete && notifier && notifier->isAtEnd();
+    co_return result;
+}
+
+QCoro::Task<QCoroIODevice::TransferResult> QCoroIODevice::transfer(QCoro::AsyncGenerator<QByteArray> source,
+                                                                  QIODevice *destination, qint64 bufferSize) {
+    const auto start = std::chrono::steady_clock::now();
+    qint64 bytesRead = 0;
+    // The destination only asks for the next chunk once it has written out all but bufferSize
+    // bytes of the previous ones, so the source fills its buffer while the destination drains its own.
+    const auto bytesWritten = co_await qCoro(destination).writeAll(countBytes(std::move(source), bytesRead), bufferSize);
+    TransferResult result;
+    result.bytesTransferred = bytesWritten;
+    result.elapsed = std::chrono::steady_clock::now() - start;
+    result.complete = bytesWritten == bytesRead;
+    co_return result;
+}
+
+QCoro::Task<bool> QCoroIODevice::waitForWriteSpace(qint64 highWaterMark) {
+    if (auto *file = qobject_cast<QFileDevice *>(mDevice.data())) {
+        // A file never emits bytesWritten(), its write buffer is only written out by flush()
+        co_return file->bytesToWrite() < highWaterMark || file->flush();
+    }
+    while (mDevice && mDevice->bytesToWrite() >= highWaterMark) {
+        if (!(co_await waitForBytesWritten(-1)).has_value()) {
+            co_return false;
+        }
+    }
+    co_return !mDevice.isNull();
+}
+
+QCoro::Task<qint64> QCoroIODevice::writeBuffer(const QByteArray &buffer, qint64 highWaterMark) {
+    qint64 bytesWritten = 0;
+    while (bytesWritten < buffer.size() && co_await waitForWriteSpace(highWaterMark)) {
+        // The whole buffer is passed on as is, so that a buffered device can share it rather than copy it
+        const auto written = bytesWritten == 0
+            ? mDevice->write(buffer)
+            : mDevice->write(buffer.constData() + bytesWritten, buffer.size() - bytesWritten);
+        if (written <= 0) {
+            break;
+        }
+        bytesWritten += written;
+    }
+    co_return bytesWritten;
+}
+
+QCoro::Task<qint64> QCoroIODevice::flushWriteBuffer() {
+    if (auto *file = qobject_cast<QFileDevice *>(mDevice.data())) {
+        file->flush();
+        co_return file->bytesToWrite();
+    }
+    while (mDevice && mDevice->bytesToWrite() > 0) {
+        if (!(co_await waitForBytesWritten(-1)).has_value()) {
+            break;
+        }
+    }
+    co_return mDevice ? mDevice->bytesToWrite() : 0;
+}
+
+QCoro::AsyncGenerator<QByteArray> QCoroIODevice::chunks(qint64 chunkSize, std::chrono::milliseconds timeout) {
+    Q_ASSERT(chunkSize > 0);
+    // The generator is lazy, so the notifier is connected right away to not miss the end of the data
+    std::shared_ptr<IODeviceReadNotifier> notifier;
+    if (mDevice) {
+        notifier = std::make_shared<IODeviceReadNotifier>(mDevice, isReadChannelFinished());
+    }
+    return readChunks(mDevice, std::move(notifier), chunkSize, timeout);
+}
+
+QCoroIODevice::Reader QCoroIODevice::reader() {
+    return Reader(mDevice, isReadChannelFinished());
+}
+
+QCoroIODevice::Reader::Reader(QIODevice *device, bool readChannelFinished)
+    : mDevice(device)
+{
+    if (device) {
+        mNotifier = std::make_unique<IODeviceReadNotifier>(device, readChannelFinished);
+    }
+}
+
+QCoroIODevice::Reader::Reader(Reader &&other) noexcept = default;
+QCoroIODevice::Reader &QCoroIODevice::Reader::operator=(Reader &&other) noexcept = default;
+QCoroIODevice::Reader::~Reader() = default;
+
+QIODevice *QCoroIODevice::Reader::device() const {
+    return mDevice;
+}
+
+bool QCoroIODevice::Reader::atEnd() const {
+    return !mNotifier || mNotifier->isAtEnd();
+}
+
+bool QCoroIODevice::Reader::hasData() const {
+    return mDevice && mDevice->bytesAvailable() > 0;
+}
+
+// The operations below wait on the notifier themselves rather than through waitForReadyRead(),
+// so that a read that has to wait for data costs just the one coroutine frame.
+
+QCoro::Task<bool> QCoroIODevice::Reader::waitForReadyRead(std::chrono::milliseconds timeout) {
+    while (!hasData()) {
+        if (atEnd() || !co_await mNotifier->wait(timeout)) {
+            co_return false;
+        }
+    }
+    co_return true;
+}
+
+QCoro::Task<QByteArray> QCoroIODevice::Reader::read(qint64 maxSize, std::chrono::milliseconds timeout) {
+    while (!hasData()) {
+        if (atEnd() || !co_await mNotifier->wait(timeout)) {
+            co_return QByteArray{};
+        }
+    }
+    co_return mDevice->read(maxSize);
+}
+
+QCoro::Task<QByteArray> QCoroIODevice::Reader::readAll(std::chrono::milliseconds timeout) {
+    while (!hasData()) {
+        if (atEnd() || !co_await mNotifier->wait(timeout)) {
+            co_return QByteArray{};
+        }
+    }
+    co_return mDevice->readAll();
+}
+
+QCoro::Task<QByteArray> QCoroIODevice::Reader::readLine(qint64 maxSize, std::chrono::milliseconds timeout) {
+    while (!hasData()) {
+        if (atEnd() || !co_await mNotifier->wait(timeout)) {
+            co_return QByteArray{};
+        }
+    }
+    co_return mDevice->readLine(maxSize);
+}
+
 QCoro::Task<bool> QCoroIODevice::waitForReadyRead(int timeout_msecs) {
     return waitForReadyRead(std::chrono::milliseconds(timeout_msecs));
 }
@@ -129,6 +608,11 @@ QCoro::Task<std::optional<qint64>> QCoroIODevice::waitForBytesWritten(std::chron
     co_return result;
 }
 
+bool QCoroIODevice::isReadChannelFinished() const {
+    // The device may be a socket or a process wrapped through a plain QIODevice pointer
+    return detail::isReadChannelFinished(mDevice.data());
+}
+
 QCoro::Task<std::optional<bool>> QCoroIODevice::waitForReadyReadImpl(std::chrono::milliseconds timeout) {
     WaitSignalHelper helper(mDevice.data(), &QIODevice::readyRead);
     co_return co_await qCoro(&helper, qOverload<bool>(&WaitSignalHelper::ready), timeout);
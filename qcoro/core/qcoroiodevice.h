@@ -5,19 +5,27 @@
 #pragma once
 
 #include "qcorotask.h"
+#include "qcoroasyncgenerator.h"
 #include "coroutine.h"
 #include "macros_p.h"
 #include "waitoperationbase_p.h"
+#include "qcoroexecutor.h"
 #include "qcorocore_export.h"
 
 #include <QPointer>
 
+#include <chrono>
+#include <memory>
+#include <span>
+
 class QIODevice;
 
 /*! \cond internal */
 
 namespace QCoro::detail {
 
+class IODeviceReadNotifier;
+
 class QCOROCORE_EXPORT QCoroIODevice {
 private:
     class OperationBase {
@@ -36,6 +44,7 @@ private:
         QMetaObject::Connection mConn;
         QMetaObject::Connection mCloseConn;
         QMetaObject::Connection mFinishedConn;
+        ScheduledCoroutine mResumeNode;
     };
 
 protected:
@@ -62,6 +71,68 @@ protected:
     template<typename T>
     friend struct awaiter_type;
 public:
+    //! Reads from a device repeatedly, staying connected to its signals between the reads.
+    /*!
+     * Created by QCoroIODevice::reader(). Unlike the one-shot operations of QCoroIODevice, which
+     * connect to the device's signals anew whenever they need to wait for data, the reader
+     * connects to the device once and reuses the connections for all its reads. Reads that
+     * find data already buffered in the device complete without suspending.
+     *
+     * The reader must outlive all its pending operations and must not be moved while any of
+     * them is pending. Only a single operation may be waiting for data at a time.
+     */
+    class Reader {
+    public:
+        Reader(Reader &&other) noexcept;
+        Reader &operator=(Reader &&other) noexcept;
+        ~Reader();
+        Q_DISABLE_COPY(Reader)
+
+        //! Returns the device the reader reads from.
+        QIODevice *device() const;
+
+        //! Whether all data have been read and no more data will arrive.
+        bool atEnd() const;
+
+        /*!
+         * \brief Waits until data are available for reading.
+         *
+         * Returns \c false if the device is closed, no more data will arrive or no data
+         * arrive within the \c timeout. If the \c timeout is -1, the operation never times out.
+         */
+        Task<bool> waitForReadyRead(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+        //! Waits for data to become available and reads up to \c maxSize bytes.
+        /*!
+         * Returns an empty QByteArray if no data arrive, see waitForReadyRead().
+         */
+        Task<QByteArray> read(qint64 maxSize, std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+        //! Waits for data to become available and reads all available data.
+        /*!
+         * Returns an empty QByteArray if no data arrive, see waitForReadyRead().
+         */
+        Task<QByteArray> readAll(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+        //! Waits for data to become available and reads a line of at most \c maxSize bytes.
+        /*!
+         * Same as QIODevice::readLine(), the line may be incomplete if only a part of it has
+         * arrived so far. Returns an empty QByteArray if no data arrive, see waitForReadyRead().
+         */
+        Task<QByteArray> readLine(qint64 maxSize = 0,
+                                  std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+    private:
+        friend class QCoroIODevice;
+        Reader(QIODevice *device, bool readChannelFinished);
+
+        //! Whether there are data to read without waiting.
+        bool hasData() const;
+
+        QPointer<QIODevice> mDevice;
+        std::unique_ptr<IODeviceReadNotifier> mNotifier;
+    };
+
     //! Constructor.
     explicit QCoroIODevice(QIODevice *device);
 
@@ -134,6 +205,80 @@ public:
     Task<QByteArray> readLine(qint64 maxSize = 0,
                               std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
 
+    /*!
+     * \brief Reads exactly \c size bytes from the device.
+     *
+     * Keeps waiting for more data until \c size bytes have been read. The data are read
+     * directly into the returned buffer, which is allocated upfront, rather than being
+     * concatenated from the individual reads.
+     *
+     * If the device is closed, no more data will arrive or no new data arrive within the
+     * \c timeout, the operation returns the fewer bytes read so far. If the \c timeout
+     * is -1, the operation will never time out.
+     */
+    Task<QByteArray> readExactly(qint64 size, std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+    /*!
+     * \brief Reads from the device until the \c delimiter is encountered.
+     *
+     * Keeps waiting for more data until the \c delimiter is found and returns the data up to
+     * and including the delimiter. No data past the delimiter are consumed from the device.
+     * The data are accumulated in a single buffer and the data already searched are not
+     * searched again when more data arrive. If \c maxSize is greater than 0, at most \c maxSize
+     * bytes are read even if the delimiter hasn't been found.
+     *
+     * If the device is closed, no more data will arrive or no new data arrive within the
+     * \c timeout, the operation returns the data read so far, without the delimiter. If the
+     * \c timeout is -1, the operation will never time out.
+     */
+    Task<QByteArray> readUntil(const QByteArray &delimiter, qint64 maxSize = 0,
+                               std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+    /*!
+     * \brief Asynchronously reads the device line by line.
+     *
+     * Returns a generator that yields each line read from the device, including the terminating
+     * newline character, waiting for more data to arrive as needed. If \c maxLineSize is greater
+     * than 0, longer lines are split into parts of \c maxLineSize bytes. A partially received
+     * line is kept by the generator and only the newly arrived data are searched for the newline.
+     *
+     * The generator ends when all data have been read and no more data will arrive, when the
+     * device is closed, or when no new data arrive within the \c timeout. The last line may
+     * lack the newline character. If the \c timeout is -1, the generator never times out.
+     */
+    AsyncGenerator<QByteArray> lines(qint64 maxLineSize = 0,
+                                     std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+    /*!
+     * \brief Asynchronously reads the device chunk by chunk.
+     *
+     * Returns a generator that yields the data from the device in chunks of up to \c chunkSize
+     * bytes, waiting for more data to arrive as needed. The generator stays connected to the
+     * device's [`readyRead()`][qdoc-qiodevice-readyRead] signal for its whole lifetime rather
+     * than waiting for it anew for each chunk.
+     *
+     * The chunks are read into a small pool of buffers. A buffer is reused for a later chunk
+     * once the consumer no longer holds a copy of it, so consuming the chunks without keeping
+     * them around doesn't allocate any memory.
+     *
+     * The generator ends when all data have been read and no more data will arrive, when the
+     * device is closed, or when no new data arrive within the \c timeout. If the \c timeout
+     * is -1, the generator never times out.
+     *
+     * [qdoc-qiodevice-readyRead]: https://doc.qt.io/qt-5/qiodevice.html#readyRead
+     */
+    AsyncGenerator<QByteArray> chunks(qint64 chunkSize,
+                                      std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+    /*!
+     * \brief Returns a reader for repeated reads from the device.
+     *
+     * The returned Reader stays connected to the device's signals for its whole lifetime,
+     * so reading from the device in a loop doesn't connect to them again for every read.
+     * The reader may outlive this wrapper.
+     */
+    Reader reader();
+
     // TODO
     //auto bytesAvailable(qint64 minBytes) {
 
@@ -155,6 +300,69 @@ public:
      */
     Task<qint64> write(const QByteArray &buffer);
 
+    //! Default limit of data pending in the device's write buffer used by writeAll().
+    static constexpr qint64 defaultHighWaterMark = 64 * 1024;
+
+    /*!
+     * \brief Writes all the \c buffers to the device, one by one, with flow control.
+     *
+     * Each buffer is passed to the device as is, without concatenating it with the others, and
+     * only once fewer than \c highWaterMark bytes are waiting in the device's write buffer. The
+     * operation finishes once all data have been written out of the device's write buffer.
+     *
+     * The \c buffers must stay alive until the operation finishes.
+     *
+     * Returns the number of bytes written, which is less than the total size of the \c buffers
+     * if an error occurs.
+     */
+    Task<qint64> writeAll(std::span<const QByteArray> buffers, qint64 highWaterMark = defaultHighWaterMark);
+
+    /*!
+     * \brief Writes all the buffers produced by the \c source to the device, with flow control.
+     *
+     * Same as writeAll(std::span<const QByteArray>, qint64), but the next buffer is requested
+     * from the \c source only once the device can accept it. A source that produces data on
+     * demand, like a file being read, thus never gets more than \c highWaterMark bytes plus
+     * a single buffer ahead of the device.
+     */
+    Task<qint64> writeAll(AsyncGenerator<QByteArray> source, qint64 highWaterMark = defaultHighWaterMark);
+
+    //! Outcome of a transfer of data between two devices.
+    struct TransferResult {
+        //! Number of bytes written to the destination.
+        qint64 bytesTransferred = 0;
+        //! How long the transfer took.
+        std::chrono::nanoseconds elapsed{0};
+        //! Whether all data from the source have been written to the destination.
+        bool complete = false;
+
+        //! Returns the average throughput of the transfer in bytes per second.
+        double bytesPerSecond() const {
+            const auto seconds = std::chrono::duration<double>(elapsed).count();
+            return seconds > 0 ? static_cast<double>(bytesTransferred) / seconds : 0.0;
+        }
+    };
+
+    //! Default size of the buffers used by uploadFrom().
+    static constexpr qint64 defaultTransferBufferSize = 64 * 1024;
+
+    /*!
+     * \brief Writes all data read from the \c source to the device.
+     *
+     * The data are read from the \c source in chunks of up to \c bufferSize bytes and written to
+     * the device with writeAll(), so the next chunk is only read once fewer than \c bufferSize
+     * bytes are waiting in the device's write buffer. Reading from the source thus overlaps with
+     * the device writing out the previous chunk, while at most about two buffers worth of data
+     * are held in memory.
+     *
+     * The transfer ends once all data have been read from the \c source, when the \c source is
+     * closed or when no data arrive from it within the \c timeout, which makes this mainly
+     * useful for uploading a file over a socket. If the \c timeout is -1, the transfer never
+     * times out.
+     */
+    Task<TransferResult> uploadFrom(QIODevice *source, qint64 bufferSize = defaultTransferBufferSize,
+                                    std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
     /*!
      * \brief Co_awaitable equivalent to [`QIODevice::waitForReadyRead`][qdoc-qiodevice-waitForReadyRead].
      *
@@ -197,7 +405,33 @@ protected:
     virtual Task<std::optional<bool>> waitForReadyReadImpl(std::chrono::milliseconds timeout);
     virtual Task<std::optional<qint64>> waitForBytesWrittenImpl(std::chrono::milliseconds timeout);
 
+    //! Whether no more data will arrive to the device, besides those already buffered.
+    /*!
+     * Operations that keep waiting for data learn about the end of the data from the device's
+     * signals, so they need to know whether the end has been reached before they connected.
+     */
+    virtual bool isReadChannelFinished() const;
+
+    //! Writes the chunks produced by the \c source to the \c destination, see uploadFrom().
+    /*!
+     * The result is \c complete when everything the \c source has produced has been written,
+     * the caller decides whether the \c source has produced all the data.
+     */
+    static Task<TransferResult> transfer(AsyncGenerator<QByteArray> source, QIODevice *destination,
+                                         qint64 bufferSize);
+
     QPointer<QIODevice> mDevice = {};
+
+private:
+    //! Waits until fewer than \c highWaterMark bytes are pending in the write buffer, \c false on error.
+    Task<bool> waitForWriteSpace(qint64 highWaterMark);
+    //! Writes the whole \c buffer once the write buffer holds fewer than \c highWaterMark bytes.
+    /*!
+     * Returns the number of bytes written, less than the size of the \c buffer on error.
+     */
+    Task<qint64> writeBuffer(const QByteArray &buffer, qint64 highWaterMark);
+    //! Waits until the write buffer is empty, returns the number of bytes left in it on error.
+    Task<qint64> flushWriteBuffer();
 };
 
 template<typename T> requires std::is_base_of_v<QIODevice, T>
@@ -4,6 +4,8 @@
 
 #include "qcoroiodevice_p.h"
 
+#include <utility>
+
 using namespace QCoro::detail;
 
 WaitSignalHelper::WaitSignalHelper(const QIODevice *device, void(QIODevice::*signalFunc)())
@@ -17,3 +19,56 @@ WaitSignalHelper::WaitSignalHelper(const QIODevice *device, void(QIODevice::*sig
     , mReady(connect(device, signalFunc, this, &WaitSignalHelper::emitReady<qint64>))
     , mAboutToClose(connect(device, &QIODevice::aboutToClose, this, [this]() { this->emitReady(static_cast<qint64>(0)); }))
 {}
+
+IODeviceReadNotifier::IODeviceReadNotifier(QIODevice *device, bool readChannelFinished)
+    : mDevice(device)
+    , mReadyRead(QObject::connect(device, &QIODevice::readyRead, device, [this]() { notify(); }))
+    , mReadChannelFinishedConn(QObject::connect(device, &QIODevice::readChannelFinished, device, [this]() {
+        mReadChannelFinished = true;
+        notify();
+    }))
+    , mAboutToClose(QObject::connect(device, &QIODevice::aboutToClose, device, [this]() {
+        mReadChannelFinished = true;
+        notify();
+    }))
+    , mReadChannelFinished(readChannelFinished)
+{
+    mTimeout.callback = &IODeviceReadNotifier::timedOut;
+    mTimeout.notifier = this;
+}
+
+IODeviceReadNotifier::~IODeviceReadNotifier() {
+    QObject::disconnect(mReadyRead);
+    QObject::disconnect(mReadChannelFinishedConn);
+    QObject::disconnect(mAboutToClose);
+}
+
+void IODeviceReadNotifier::suspend(std::coroutine_handle<> awaitingCoroutine, std::chrono::milliseconds timeout) {
+    Q_ASSERT(!mAwaitingCoroutine);
+    mAwaitingCoroutine = awaitingCoroutine;
+    mTimedOut = false;
+    if (timeout.count() > -1) {
+        TimerWheel::current().add(mTimeout, timeout);
+    }
+}
+
+bool IODeviceReadNotifier::resume() {
+    mTimeout.cancel();
+    return !mTimedOut;
+}
+
+void IODeviceReadNotifier::notify() {
+    if (!mAwaitingCoroutine) {
+        return;
+    }
+    mTimeout.cancel();
+    // Delayed trigger, same as the one-shot operations
+    mResumeNode.coroutine = std::exchange(mAwaitingCoroutine, nullptr);
+    QCoro::ThreadExecutor::current().post(mResumeNode);
+}
+
+void IODeviceReadNotifier::timedOut(TimerEntry *entry) {
+    auto *notifier = static_cast<Timeout *>(entry)->notifier;
+    notifier->mTimedOut = true;
+    std::exchange(notifier->mAwaitingCoroutine, nullptr).resume();
+}
@@ -5,7 +5,13 @@
 #pragma once
 
 #include <QIODevice>
+#include <QPointer>
 #include "qcorocore_export.h"
+#include "coroutine.h"
+#include "qcoroexecutor.h"
+#include "impl/timerwheel.h"
+
+#include <chrono>
 
 namespace QCoro::detail {
 
@@ -35,4 +41,104 @@ protected:
     QMetaObject::Connection mAboutToClose;
 };
 
-} // namespace QCoro::detail
\ No newline at end of file
+//! Wakes up a coroutine waiting for data to read from a device.
+/*!
+ * Unlike WaitSignalHelper, the notifier stays connected to the device between the waits, so
+ * a coroutine reading from the device repeatedly doesn't create a helper object and connect
+ * to the device's signals for every single wait.
+ */
+class QCOROCORE_EXPORT IODeviceReadNotifier {
+public:
+    //! Connects to the \c device, \c readChannelFinished tells whether no more data will arrive already.
+    explicit IODeviceReadNotifier(QIODevice *device, bool readChannelFinished = false);
+    ~IODeviceReadNotifier();
+    Q_DISABLE_COPY(IODeviceReadNotifier)
+    IODeviceReadNotifier(IODeviceReadNotifier &&) = delete;
+    IODeviceReadNotifier &operator=(IODeviceReadNotifier &&) = delete;
+
+    //! Awaitable that's resumed once new data arrive, the read channel finishes or the device is closed.
+    /*!
+     * Produces \c false if the timeout expires first.
+     */
+    class WaitOperation {
+    public:
+        bool await_ready() const noexcept {
+            return false;
+        }
+        void await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+            mNotifier.suspend(awaitingCoroutine, mTimeout);
+        }
+        bool await_resume() noexcept {
+            return mNotifier.resume();
+        }
+
+    private:
+        friend class IODeviceReadNotifier;
+        WaitOperation(IODeviceReadNotifier &notifier, std::chrono::milliseconds timeout)
+            : mNotifier(notifier), mTimeout(timeout)
+        {}
+
+        IODeviceReadNotifier &mNotifier;
+        std::chrono::milliseconds mTimeout;
+    };
+
+    //! Waits for the device to become ready for reading, for at most \c timeout, -1 waits forever.
+    WaitOperation wait(std::chrono::milliseconds timeout) {
+        return WaitOperation{*this, timeout};
+    }
+
+    //! Whether the device has signalled that no more data will arrive.
+    bool isReadChannelFinished() const noexcept {
+        return mReadChannelFinished;
+    }
+
+    //! Whether all data have been read from the device and no more will arrive, so there's no point in waiting.
+    bool isAtEnd() const {
+        if (!mDevice || !mDevice->isReadable()) {
+            return true;
+        }
+        if (mDevice->bytesAvailable() > 0) {
+            return false;
+        }
+        return mDevice->isSequential() ? mReadChannelFinished : mDevice->atEnd();
+    }
+
+private:
+    void suspend(std::coroutine_handle<> awaitingCoroutine, std::chrono::milliseconds timeout);
+    bool resume();
+    void notify();
+    static void timedOut(TimerEntry *entry);
+
+    struct Timeout : TimerEntry {
+        IODeviceReadNotifier *notifier = nullptr;
+    };
+
+    QPointer<QIODevice> mDevice;
+    QMetaObject::Connection mReadyRead;
+    QMetaObject::Connection mReadChannelFinishedConn;
+    QMetaObject::Connection mAboutToClose;
+    std::coroutine_handle<> mAwaitingCoroutine;
+    Timeout mTimeout;
+    ScheduledCoroutine mResumeNode;
+    bool mReadChannelFinished = false;
+    bool mTimedOut = false;
+};
+
+//! Tells whether no more data will arrive to a device of a specific type, see registerReadChannelFinishedCheck().
+using ReadChannelFinishedCheck = bool (*)(const QIODevice *device);
+
+//! Registers the \c check for devices inheriting the class described by the \c metaObject.
+/*!
+ * Used by QCoro libraries for the device types they wrap, so that isReadChannelFinished()
+ * knows about devices from Qt modules QCoro Core doesn't link to.
+ */
+QCOROCORE_EXPORT void registerReadChannelFinishedCheck(const QMetaObject *metaObject, ReadChannelFinishedCheck check);
+
+//! Whether no more data will arrive to the \c device, besides those already buffered.
+/*!
+ * Same as the isReadChannelFinished() of the QCoro wrapper for the actual type of the \c device,
+ * e.g. a socket that has disconnected has finished even though it's still open.
+ */
+QCOROCORE_EXPORT bool isReadChannelFinished(const QIODevice *device);
+
+} // namespace QCoro::detail
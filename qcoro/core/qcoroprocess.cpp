@@ -7,12 +7,26 @@
 #if QT_CONFIG(process)
 
 #include "qcoroprocess.h"
+#include "qcoroiodevice_p.h"
 #include "qcorosignal.h"
 
 #include <QProcess>
 
 using namespace QCoro::detail;
 
+namespace {
+
+bool isProcessReadChannelFinished(const QIODevice *device) {
+    return !device || static_cast<const QProcess *>(device)->state() == QProcess::NotRunning;
+}
+
+void registerProcessCheck() {
+    QCoro::detail::registerReadChannelFinishedCheck(&QProcess::staticMetaObject, &isProcessReadChannelFinished);
+}
+Q_CONSTRUCTOR_FUNCTION(registerProcessCheck)
+
+} // namespace
+
 QCoroProcess::QCoroProcess(QProcess *process)
     : QCoroIODevice(process)
 {}
@@ -31,6 +45,20 @@ QCoro::Task<bool> QCoroProcess::waitForStarted(std::chrono::milliseconds timeout
     co_return process->state() == QProcess::Running;
 }
 
+QCoro::Task<bool> QCoroProcess::waitForStarted(QCoro::CancellationToken cancellationToken,
+                                               std::chrono::milliseconds timeout) {
+    auto *process = qobject_cast<QProcess *>(mDevice.data());
+    if (process->state() == QProcess::Starting) {
+        const auto started = co_await qCoro(process, &QProcess::started, cancellationToken, timeout);
+        if (!started.has_value() && cancellationToken.isCancellationRequested() && mDevice) {
+            process->kill();
+        }
+        co_return started.has_value();
+    }
+
+    co_return process->state() == QProcess::Running;
+}
+
 QCoro::Task<bool> QCoroProcess::waitForFinished(int timeout_msecs) {
     return waitForFinished(std::chrono::milliseconds{timeout_msecs});
 }
@@ -45,6 +73,21 @@ QCoro::Task<bool> QCoroProcess::waitForFinished(std::chrono::milliseconds timeou
     co_return finished.has_value();
 }
 
+QCoro::Task<bool> QCoroProcess::waitForFinished(QCoro::CancellationToken cancellationToken,
+                                                std::chrono::milliseconds timeout) {
+    auto *process = qobject_cast<QProcess *>(mDevice.data());
+    if (process->state() == QProcess::NotRunning) {
+        co_return false;
+    }
+
+    const auto finished = co_await qCoro(process, qOverload<int, QProcess::ExitStatus>(&QProcess::finished),
+                                         cancellationToken, timeout);
+    if (!finished.has_value() && cancellationToken.isCancellationRequested() && mDevice) {
+        process->kill();
+    }
+    co_return finished.has_value();
+}
+
 QCoro::Task<bool> QCoroProcess::start(QIODevice::OpenMode mode, std::chrono::milliseconds timeout) {
     static_cast<QProcess *>(mDevice.data())->start(mode);
     return waitForStarted(timeout);
@@ -56,4 +99,8 @@ QCoro::Task<bool> QCoroProcess::start(const QString &program, const QStringList
     return waitForStarted(timeout);
 }
 
+bool QCoroProcess::isReadChannelFinished() const {
+    return isProcessReadChannelFinished(mDevice.data());
+}
+
 #endif // QT_CONFIG(process)
@@ -6,6 +6,7 @@
 
 #include "waitoperationbase_p.h"
 #include "qcoroiodevice.h"
+#include "qcorocancellationtoken.h"
 #include "qcorocore_export.h"
 
 #include <chrono>
@@ -50,6 +51,18 @@ public:
      */
     Task<bool> waitForStarted(std::chrono::milliseconds timeout);
 
+    /*!
+     * \brief Waits for the process to start, unless cancelled.
+     *
+     * Same as waitForStarted(std::chrono::milliseconds), but if cancellation is requested
+     * through the \c cancellationToken before the process has started, the process is killed.
+     *
+     * Returns true if the process has started successfully, otherwise returns false (if the
+     * operation timed out, was cancelled or if an error occured).
+     */
+    Task<bool> waitForStarted(QCoro::CancellationToken cancellationToken,
+                              std::chrono::milliseconds timeout = std::chrono::seconds(30));
+
     /*!
      * \brief Co_awaitable equivalent to [`QProcess::waitForFinished()`][qtdoc-qprocess-waitForFinished].
      *
@@ -75,6 +88,18 @@ public:
      */
     Task<bool> waitForFinished(std::chrono::milliseconds timeout);
 
+    /*!
+     * \brief Waits for the process to finish, unless cancelled.
+     *
+     * Same as waitForFinished(std::chrono::milliseconds), but if cancellation is requested
+     * through the \c cancellationToken before the process has finished, the process is killed.
+     *
+     * Returns true if the process has finished, otherwise returns false (if the operation timed
+     * out, was cancelled, if an error occured or if this `QProcess` is already finished).
+     */
+    Task<bool> waitForFinished(QCoro::CancellationToken cancellationToken,
+                               std::chrono::milliseconds timeout = std::chrono::seconds(30));
+
     /*!
      * \brief Executes a new process and waits for it to start
      *
@@ -109,6 +134,9 @@ public:
     Task<bool> start(const QString &program, const QStringList &arguments,
                      QIODevice::OpenMode mode = QIODevice::ReadWrite,
                      std::chrono::milliseconds timeout = std::chrono::seconds(30));
+
+private:
+    bool isReadChannelFinished() const override;
 };
 
 } // namespace QCoro::detail
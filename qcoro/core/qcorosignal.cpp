@@ -0,0 +1,14 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorosignal.h"
+
+#include <memory>
+
+using namespace QCoro::detail;
+
+SignalContext *SignalContext::current() {
+    static thread_local std::unique_ptr<SignalContext> context{new SignalContext};
+    return context.get();
+}
@@ -9,18 +9,29 @@
 #include "concepts_p.h"
 #include "qcorotask.h"
 #include "qcoroasyncgenerator.h"
+#include "qcorocancellationtoken.h"
+#include "qcoroexecutor.h"
 
 #include <QObject>
 #include <QPointer>
+#include <QThread>
 #include <QTimer>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <optional>
 #include <deque>
+#include <iterator>
+#include <limits>
 #include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "impl/isqprivatesignal.h"
+#include "impl/signalcontext.h"
+#include "impl/timerwheel.h"
 
 namespace QCoro::detail {
 
@@ -99,36 +110,112 @@ public:
 
     QCoroSignalBase(const QCoroSignalBase &) = delete;
     QCoroSignalBase &operator=(const QCoroSignalBase &) = delete;
-    QCoroSignalBase(QCoroSignalBase &&) noexcept = default;
-    QCoroSignalBase &operator=(QCoroSignalBase &&) noexcept = default;
+
+    QCoroSignalBase(QCoroSignalBase &&other) noexcept
+        : mObj(std::move(other.mObj))
+        , mFuncPtr(std::forward<FuncPtr>(other.mFuncPtr))
+        , mConn(std::move(other.mConn))
+        , mContext(other.mContext)
+        , mHandle(std::exchange(other.mHandle, {}))
+        , mTimeout(other.mTimeout) {
+        // The awaiter must not be moved once it's been suspended
+        Q_ASSERT(!other.mTimeoutEntry.isScheduled());
+    }
+
+    QCoroSignalBase &operator=(QCoroSignalBase &&other) noexcept {
+        disconnectSignal();
+        mObj = std::move(other.mObj);
+        mFuncPtr = std::forward<FuncPtr>(other.mFuncPtr);
+        mConn = std::move(other.mConn);
+        mContext = other.mContext;
+        mHandle = std::exchange(other.mHandle, {});
+        mTimeout = other.mTimeout;
+        return *this;
+    }
 
     ~QCoroSignalBase() {
-        if (static_cast<bool>(mConn)) {
-            QObject::disconnect(mConn);
-        }
+        stopTimeout();
+        disconnectSignal();
     }
 
+    //! Starts the timeout, if any, which resumes the \c awaitingCoroutine when it expires.
     void handleTimeout(std::coroutine_handle<> awaitingCoroutine) {
-        if (mTimeoutTimer) {
-            QObject::connect(mTimeoutTimer.get(), &QTimer::timeout, mObj,
-                [this, awaitingCoroutine]() {
-                    QObject::disconnect(mConn);
-                    awaitingCoroutine.resume();
-                }, Qt::DirectConnection); // force coro to be resumed on our thread, not mObj's thread
-            mTimeoutTimer->start();
+        if (mTimeout.count() > -1) {
+            mTimeoutEntry.callback = &QCoroSignalBase::timedOut;
+            mTimeoutEntry.signal = this;
+            mTimeoutEntry.awaitingCoroutine = awaitingCoroutine;
+            TimerWheel::current().add(mTimeoutEntry, mTimeout);
         }
     }
 
 protected:
     QCoroSignalBase(T *obj, FuncPtr &&funcPtr, std::chrono::milliseconds timeout)
-        : mObj(obj), mFuncPtr(std::forward<FuncPtr>(funcPtr)) {
-        if (timeout.count() > -1) {
-            mTimeoutTimer = std::make_unique<QTimer>();
-            mTimeoutTimer->setInterval(timeout);
-            mTimeoutTimer->setSingleShot(true);
+        : mObj(obj), mFuncPtr(std::forward<FuncPtr>(funcPtr))
+        , mContext(SignalContext::current())
+        , mTimeout(timeout)
+    {}
+
+    //! Connects the signal to the thread's SignalContext, the \c handler is invoked with the awaiter and the signal arguments.
+    /*!
+     * The handler is invoked in the awaiting thread, but only as long as the awaiter is connected.
+     */
+    template<typename Awaiter, typename Handler>
+    void connectSignal(Awaiter *awaiter, Handler handler) {
+        Q_ASSERT(!mHandle.isValid());
+        mHandle = mContext->attach(awaiter);
+        mConn = QObject::connect(
+            mObj, mFuncPtr, mContext,
+            [context = mContext, handle = mHandle, handler](auto && ...args) {
+                // The invocation may have been queued before the awaiter disconnected
+                if (auto *awaiter = static_cast<Awaiter *>(context->target(handle)); awaiter != nullptr) {
+                    handler(awaiter, std::forward<decltype(args)>(args)...);
+                }
+            },
+            Qt::QueuedConnection);
+    }
+
+    //! Connects the signal directly, the \c handler is invoked in the emitting thread with the awaiter and the signal arguments.
+    /*!
+     * The handler is invoked at most once, with the awaiter claimed from the context, so the
+     * signal arguments can be stored in the awaiter without being copied into a queued event.
+     * Resuming the awaiting coroutine in its thread is up to the handler.
+     */
+    template<typename Awaiter, typename Handler>
+    void connectSignalDirect(Awaiter *awaiter, Handler handler) {
+        Q_ASSERT(!mHandle.isValid());
+        mHandle = mContext->attach(awaiter);
+        mConn = QObject::connect(
+            mObj, mFuncPtr, mContext,
+            [context = mContext, handle = mHandle, handler](auto && ...args) {
+                context->claim(handle, [&](void *awaiter) {
+                    handler(static_cast<Awaiter *>(awaiter), std::forward<decltype(args)>(args)...);
+                });
+            },
+            Qt::DirectConnection);
+    }
+
+    //! Points the connection to the \c awaiter after it's been moved.
+    void reattachSignal(void *awaiter) {
+        if (mHandle.isValid()) {
+            mContext->retarget(mHandle, awaiter);
         }
     }
 
+    //! Disconnects the signal, returns \c false if the awaiter has already been claimed by the signal.
+    bool disconnectSignal() {
+        if (static_cast<bool>(mConn)) {
+            QObject::disconnect(mConn);
+        }
+        if (mHandle.isValid()) {
+            return mContext->detach(std::exchange(mHandle, {}));
+        }
+        return false;
+    }
+
+    void stopTimeout() {
+        mTimeoutEntry.cancel();
+    }
+
     template<typename... Args>
     struct select_last {
         using type = typename decltype((std::type_identity<Args>{}, ...))::type;
@@ -156,11 +243,29 @@ protected:
         std::invoke(std::forward<StoreResultCb>(storeResult));
     }
 
+private:
+    struct Timeout : TimerEntry {
+        QCoroSignalBase *signal = nullptr;
+        std::coroutine_handle<> awaitingCoroutine = {};
+    };
+
+    static void timedOut(TimerEntry *entry) {
+        auto *timeout = static_cast<Timeout *>(entry);
+        // A signal emitted in another thread may have claimed the awaiter just now, in which
+        // case the awaiting coroutine is already scheduled to be resumed.
+        if (timeout->signal->disconnectSignal()) {
+            timeout->awaitingCoroutine.resume();
+        }
+    }
+
 protected:
     QPointer<T> mObj;
     FuncPtr mFuncPtr;
     QMetaObject::Connection mConn;
-    std::unique_ptr<QTimer> mTimeoutTimer;
+    SignalContext *mContext;
+    SignalContext::Handle mHandle;
+    std::chrono::milliseconds mTimeout;
+    Timeout mTimeoutEntry;
 };
 
 template<concepts::QObject T, typename FuncPtr>
@@ -168,79 +273,115 @@ class QCoroSignal : public QCoroSignalBase<T, FuncPtr> {
 public:
     using typename QCoroSignalBase<T, FuncPtr>::result_type;
 
-    QCoroSignal(T *obj, FuncPtr &&ptr, std::chrono::milliseconds timeout)
+    QCoroSignal(T *obj, FuncPtr &&ptr, std::chrono::milliseconds timeout,
+                QCoro::CancellationToken cancellationToken = {})
         : QCoroSignalBase<T, FuncPtr>(obj, std::forward<FuncPtr>(ptr), timeout)
-        , mDummyReceiver(std::make_unique<QObject>()) {}
+        , mCancellationToken(std::move(cancellationToken)) {}
     QCoroSignal(const QCoroSignal &) = delete;
     QCoroSignal(QCoroSignal &&other) noexcept
         : QCoroSignalBase<T, FuncPtr>(std::move(other))
         , mResult(std::move(other.mResult))
-        , mDummyReceiver(std::move(other.mDummyReceiver)) {
-        if (this->mConn) {
-            QObject::disconnect(this->mConn);
-            setupConnection();
-        }
+        , mCancellationToken(std::move(other.mCancellationToken)) {
+        // The awaiter must not be moved once it's been suspended
+        Q_ASSERT(!other.mCancellationCallback.has_value());
+        this->reattachSignal(this);
     }
 
     QCoroSignal &operator=(QCoroSignal &&other) noexcept {
         QCoroSignalBase<T, FuncPtr>::operator=(std::move(other));
         std::swap(mResult, other.mResult);
-        std::swap(mDummyReceiver, other.mDummyReceiver);
-        if (this->mConn) {
-            QObject::disconnect(this->mConn);
-            setupConnection();
-        }
+        std::swap(mCancellationToken, other.mCancellationToken);
+        Q_ASSERT(!mCancellationCallback.has_value() && !other.mCancellationCallback.has_value());
+        this->reattachSignal(this);
         return *this;
     }
 
     QCoroSignal &operator=(const QCoroSignal &) = delete;
-    ~QCoroSignal() = default;
+
+    ~QCoroSignal() {
+        // Disconnect before mResult is destroyed, a signal emitted in another thread may be storing it right now
+        this->disconnectSignal();
+    }
 
 
     bool await_ready() const noexcept {
-        return this->mObj.isNull();
+        return this->mObj.isNull() || mCancellationToken.isCancellationRequested();
     }
 
     void await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
         this->handleTimeout(awaitingCoroutine);
         mAwaitingCoroutine = awaitingCoroutine;
+        mExecutor = &ThreadExecutor::current();
         setupConnection();
+        if (mCancellationToken.canBeCancelled()) {
+            mCancellationCallback.emplace(mCancellationToken, CancelRequest{this->mContext, this->mHandle});
+        }
     }
 
     result_type await_resume() {
+        this->stopTimeout();
+        this->disconnectSignal();
         return std::move(mResult);
     }
 
 private:
     void setupConnection() {
-        Q_ASSERT(!this->mConn);
-        this->mConn = QObject::connect(
-            this->mObj, this->mFuncPtr, this->mDummyReceiver.get(),
-            [this](auto &&...args) mutable {
-                if (this->mTimeoutTimer) {
-                    this->mTimeoutTimer->stop();
-                }
-                QObject::disconnect(this->mConn);
+        // The signal is connected directly, so that its arguments are stored right into mResult
+        // instead of being copied into a queued event first. Only the resumption of the awaiting
+        // coroutine is deferred to the event loop of its thread, regardless of which thread
+        // emits the signal, so the coroutine is never resumed from within the emit.
+        this->connectSignalDirect(this, [](QCoroSignal *self, auto && ...args) {
+            self->storeResult([self](auto && ...args) {
+                self->mResult.emplace(std::forward<decltype(args)>(args)...);
+            }, std::forward<decltype(args)>(args)...);
+
+            if (QThread::currentThread() == self->mContext->thread()) {
+                // Otherwise the timeout is stopped once resumed, the timer wheel belongs to the awaiting thread
+                self->stopTimeout();
+            }
+            self->mResumeNode.coroutine = self->mAwaitingCoroutine;
+            self->mExecutor->post(self->mResumeNode);
+        });
+    }
 
-                this->storeResult([this](auto && ...args) {
-                    mResult.emplace(std::forward<decltype(args)>(args)...);
-                }, std::forward<decltype(args)>(args)...);
+    //! Resumes the awaiting coroutine with an empty result, unless the signal has been emitted already.
+    void cancel() {
+        if (this->disconnectSignal()) {
+            this->stopTimeout();
+            mAwaitingCoroutine.resume();
+        }
+    }
 
-                if (mAwaitingCoroutine) {
-                    mAwaitingCoroutine.resume();
+    //! Invoked when cancellation is requested, possibly from a different thread.
+    struct CancelRequest {
+        void operator()() const {
+            // Queue the cancellation into the awaiting coroutine's thread. The cancellation is
+            // dropped if the awaiter has been resumed or destroyed in the meantime.
+            QMetaObject::invokeMethod(context, [context = context, handle = handle]() {
+                if (auto *signal = static_cast<QCoroSignal *>(context->target(handle)); signal != nullptr) {
+                    signal->cancel();
                 }
-            },
-            Qt::QueuedConnection);
-    }
+            }, Qt::QueuedConnection);
+        }
+
+        SignalContext *context;
+        SignalContext::Handle handle;
+    };
 
     result_type mResult;
     std::coroutine_handle<> mAwaitingCoroutine;
-    std::unique_ptr<QObject> mDummyReceiver;
+    ThreadExecutor *mExecutor = nullptr;
+    ScheduledCoroutine mResumeNode;
+    QCoro::CancellationToken mCancellationToken;
+    std::optional<QCoro::CancellationCallback<CancelRequest>> mCancellationCallback;
 };
 
 template<concepts::QObject T, typename FuncPtr>
 QCoroSignal(T *, FuncPtr &&, std::chrono::milliseconds) -> QCoroSignal<T, FuncPtr>;
 
+template<concepts::QObject T, typename FuncPtr>
+QCoroSignal(T *, FuncPtr &&, std::chrono::milliseconds, QCoro::CancellationToken) -> QCoroSignal<T, FuncPtr>;
+
 template<concepts::QObject T, typename FuncPtr>
 class QCoroSignalQueue : public QCoroSignalBase<T, FuncPtr> {
 public:
@@ -304,35 +445,161 @@ public:
 
 private:
     void setupConnection() {
-        if (this->mConn) {
-            return;
-        }
-        this->mConn = QObject::connect(
-            this->mObj, this->mFuncPtr, &this->mDummyReceiver,
-            [this](auto && ...args) mutable {
-                if (this->mTimeoutTimer) {
-                    this->mTimeoutTimer->stop();
-                }
-
-                this->storeResult([this](auto && ...args) {
-                    mQueue.emplace_back(std::forward<decltype(args)>(args)...);
-                }, std::forward<decltype(args)>(args) ...);
+        this->connectSignal(this, [](QCoroSignalQueue *self, auto && ...args) {
+            self->stopTimeout();
 
-                if (mAwaitingCoroutine) {
-                    mAwaitingCoroutine.resume();
-                }
-            }, Qt::QueuedConnection);
+            self->storeResult([self](auto && ...args) {
+                self->mQueue.emplace_back(std::forward<decltype(args)>(args)...);
+            }, std::forward<decltype(args)>(args) ...);
 
+            // Only resume the coroutine if it's actually waiting for the signal
+            if (auto awaitingCoroutine = std::exchange(self->mAwaitingCoroutine, nullptr); awaitingCoroutine) {
+                awaitingCoroutine.resume();
+            }
+        });
     }
 
     std::coroutine_handle<> mAwaitingCoroutine;
     std::deque<typename result_type::value_type> mQueue;
-    QObject mDummyReceiver;
 };
 
 template<concepts::QObject T, typename FuncPtr>
 QCoroSignalQueue(T *, FuncPtr &&, std::chrono::milliseconds) -> QCoroSignalQueue<T, FuncPtr>;
 
+//! Queues signal emissions and hands them out in batches.
+/*!
+ * Unlike QCoroSignalQueue, which resumes the awaiting coroutine from the signal handler for
+ * every single emission, the coroutine is resumed through the thread's executor, so all
+ * emissions delivered in the meantime are handed to it at once. When \c maxLatency is set,
+ * the coroutine is resumed only once \c maxBatchSize emissions are queued, or once the oldest
+ * queued emission has waited for \c maxLatency.
+ */
+template<concepts::QObject T, typename FuncPtr>
+class QCoroSignalBatchQueue : public QCoroSignalBase<T, FuncPtr> {
+public:
+    using typename QCoroSignalBase<T, FuncPtr>::result_type;
+    using value_type = typename result_type::value_type;
+
+    QCoroSignalBatchQueue(T *obj, FuncPtr &&ptr, std::size_t maxBatchSize,
+                          std::chrono::milliseconds maxLatency, std::chrono::milliseconds timeout)
+        : QCoroSignalBase<T, FuncPtr>(obj, std::forward<FuncPtr>(ptr), timeout)
+        , mMaxBatchSize(maxBatchSize)
+        , mMaxLatency(maxLatency) {
+        Q_ASSERT(maxBatchSize > 0);
+        mLatencyEntry.callback = &QCoroSignalBatchQueue::latencyExpired;
+        mLatencyEntry.queue = this;
+        setupConnection();
+    }
+
+    QCoroSignalBatchQueue(QCoroSignalBatchQueue &&) = delete;
+    QCoroSignalBatchQueue(const QCoroSignalBatchQueue &) = delete;
+    QCoroSignalBatchQueue &operator=(QCoroSignalBatchQueue &&) = delete;
+    QCoroSignalBatchQueue &operator=(const QCoroSignalBatchQueue &) = delete;
+    ~QCoroSignalBatchQueue() = default;
+
+    //! Returns an awaitable that produces the next batch, an empty batch on timeout.
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            explicit Awaiter(QCoroSignalBatchQueue &queue)
+                : mQueue(queue)
+            {}
+
+            bool await_ready() const noexcept {
+                return !mQueue.isValid() || mQueue.isBatchReady();
+            }
+            void await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+                mQueue.setAwaiter(awaitingCoroutine);
+            }
+            std::vector<value_type> await_resume() {
+                return mQueue.takeBatch();
+            }
+
+        private:
+            QCoroSignalBatchQueue &mQueue;
+        };
+        return Awaiter{*this};
+    }
+
+    bool isValid() const {
+        return !this->mObj.isNull();
+    }
+
+    //! Returns whether a batch can be taken without waiting.
+    bool isBatchReady() const {
+        return !mQueue.empty()
+            && (mMaxLatency.count() <= 0 || mQueue.size() >= mMaxBatchSize
+                || mBatchDeadline <= TimerWheel::Clock::now());
+    }
+
+    //! Takes up to maxBatchSize oldest emissions from the queue.
+    std::vector<value_type> takeBatch() {
+        const auto count = std::min(mQueue.size(), mMaxBatchSize);
+        std::vector<value_type> batch;
+        batch.reserve(count);
+        std::move(mQueue.begin(), mQueue.begin() + count, std::back_inserter(batch));
+        mQueue.erase(mQueue.begin(), mQueue.begin() + count);
+        // The remaining emissions arrived after the oldest one of this batch, so they keep its deadline.
+        return batch;
+    }
+
+    void setAwaiter(std::coroutine_handle<> awaiter) {
+        mAwaitingCoroutine = awaiter;
+        if (mQueue.empty()) {
+            this->handleTimeout(awaiter);
+        } else {
+            // Some emissions are queued already, wait for the rest of the batch
+            TimerWheel::current().add(mLatencyEntry, mBatchDeadline);
+        }
+    }
+
+private:
+    void setupConnection() {
+        this->connectSignal(this, [](QCoroSignalBatchQueue *self, auto && ...args) {
+            self->storeResult([self](auto && ...args) {
+                self->mQueue.emplace_back(std::forward<decltype(args)>(args)...);
+            }, std::forward<decltype(args)>(args) ...);
+
+            if (self->mQueue.size() == 1) {
+                self->mBatchDeadline = TimerWheel::Clock::now() + self->mMaxLatency;
+            }
+            if (!self->mAwaitingCoroutine) {
+                return;
+            }
+            if (self->mMaxLatency.count() <= 0 || self->mQueue.size() >= self->mMaxBatchSize) {
+                self->scheduleResume();
+            } else if (self->mQueue.size() == 1) {
+                self->stopTimeout();
+                TimerWheel::current().add(self->mLatencyEntry, self->mBatchDeadline);
+            }
+        });
+    }
+
+    //! Resumes the awaiting coroutine from the executor, after the signal emissions already
+    //! queued in the event loop have been delivered.
+    void scheduleResume() {
+        this->stopTimeout();
+        mLatencyEntry.cancel();
+        mResumeNode.coroutine = std::exchange(mAwaitingCoroutine, nullptr);
+        ThreadExecutor::current().post(mResumeNode);
+    }
+
+    struct LatencyEntry : TimerEntry {
+        QCoroSignalBatchQueue *queue = nullptr;
+    };
+
+    static void latencyExpired(TimerEntry *entry) {
+        static_cast<LatencyEntry *>(entry)->queue->scheduleResume();
+    }
+
+    const std::size_t mMaxBatchSize;
+    const std::chrono::milliseconds mMaxLatency;
+    TimerWheel::Clock::time_point mBatchDeadline;
+    std::coroutine_handle<> mAwaitingCoroutine;
+    std::deque<value_type> mQueue;
+    LatencyEntry mLatencyEntry;
+    ScheduledCoroutine mResumeNode;
+};
+
 
 } // namespace QCoro::detail
 
@@ -356,6 +623,21 @@ inline auto qCoro(T *obj, FuncPtr &&ptr, std::chrono::milliseconds timeout)
     co_return std::move(result);
 }
 
+//! Allows co_awaiting on signal emission until the operation is cancelled.
+/*!
+ * Same as qCoro(T *, FuncPtr &&, std::chrono::milliseconds), but the wait can additionally be
+ * cancelled through the \c cancellationToken. When cancellation is requested, the awaiting
+ * coroutine is resumed from the event loop of its thread with an empty optional, same as on
+ * timeout.
+ */
+template<QCoro::detail::concepts::QObject T, typename FuncPtr>
+inline auto qCoro(T *obj, FuncPtr &&ptr, QCoro::CancellationToken cancellationToken,
+                  std::chrono::milliseconds timeout = std::chrono::milliseconds{-1})
+    -> QCoro::Task<typename QCoro::detail::QCoroSignal<T, FuncPtr>::result_type> {
+    auto result = co_await QCoro::detail::QCoroSignal(obj, std::forward<FuncPtr>(ptr), timeout, std::move(cancellationToken));
+    co_return std::move(result);
+}
+
 //! Allows co_awaiting on signal emission.
 /*!
  * Returns an Awaitable object that allows co_awaiting for a signal to
@@ -398,3 +680,42 @@ inline auto qCoroSignalListener(T *obj, FuncPtr &&ptr,
 
     return innerGenerator(std::make_unique<SignalQueue>(obj, std::forward<FuncPtr>(ptr), timeout));
 }
+
+//! Allows co_awaiting on signal emissions in batches.
+/*!
+ * Same as qCoroSignalListener(), but each value produced by the generator is a batch of
+ * the emissions queued since the previous batch, up to \c maxBatchSize of them. A burst
+ * of emissions thus resumes the consuming coroutine only once.
+ *
+ * If \c maxLatency is set, the consumer is resumed only once \c maxBatchSize emissions
+ * are queued, or once the oldest queued emission has waited for \c maxLatency, trading
+ * latency for fewer, larger batches.
+ *
+ * When the \c timeout is set, the generator ends if the signal is not emitted within the
+ * specified timeout.
+ */
+template<QCoro::detail::concepts::QObject T, typename FuncPtr>
+inline auto qCoroSignalBatchListener(T *obj, FuncPtr &&ptr,
+                                     std::size_t maxBatchSize = std::numeric_limits<std::size_t>::max(),
+                                     std::chrono::milliseconds maxLatency = std::chrono::milliseconds{0},
+                                     std::chrono::milliseconds timeout = std::chrono::milliseconds{-1})
+    -> QCoro::AsyncGenerator<std::vector<typename QCoro::detail::QCoroSignalBatchQueue<T, FuncPtr>::value_type>> {
+
+    using BatchQueue = QCoro::detail::QCoroSignalBatchQueue<T, FuncPtr>;
+
+    // See qCoroSignalListener() for why the generator is wrapped
+    constexpr auto innerGenerator = [](std::unique_ptr<BatchQueue> batchQueue) ->
+        QCoro::AsyncGenerator<std::vector<typename BatchQueue::value_type>> {
+        Q_FOREVER {
+            auto batch = co_await *batchQueue;
+            if (batch.empty()) { // timeout
+                break;
+            }
+
+            co_yield std::move(batch);
+        }
+    };
+
+    return innerGenerator(std::make_unique<BatchQueue>(obj, std::forward<FuncPtr>(ptr), maxBatchSize,
+                                                       maxLatency, timeout));
+}
@@ -6,55 +6,12 @@
 #include "qcorosignal.h"
 
 #include <QThread>
-#include <QEvent>
-#include <QCoreApplication>
 
 using namespace QCoro;
 using namespace QCoro::detail;
 
-namespace QCoro::detail {
-
-class ContextHelper : public QObject {
-    Q_OBJECT
-public:
-    static QEvent::Type eventType;
-
-    explicit ContextHelper(std::coroutine_handle<> awaiter, QThread *thread)
-        : mThread(thread)
-        , mAwaiter(awaiter)
-    {}
-
-    bool event(QEvent *event) override {
-        if (event->type() == eventType) {
-            Q_ASSERT(QThread::currentThread() == mThread);
-            mAwaiter.resume();
-            return true;
-        }
-
-        return QObject::event(event);
-    }
-
-private:
-    QThread *mThread;
-    std::coroutine_handle<> mAwaiter;
-};
-
-QEvent::Type ContextHelper::eventType = static_cast<QEvent::Type>(QEvent::registerEventType());
-
-class ThreadContextPrivate {
-public:
-    explicit ThreadContextPrivate(QThread *thread)
-        : mThread(thread)
-    {}
-
-    QThread *mThread;
-    std::unique_ptr<ContextHelper> mContext;
-};
-
-} // namespace QCoro::detail
-
 ThreadContext::ThreadContext(QThread *thread)
-    : d(std::make_unique<ThreadContextPrivate>(thread))
+    : mThread(thread)
 {}
 
 #ifdef Q_CC_GNU
@@ -68,17 +25,14 @@ bool ThreadContext::await_ready() const noexcept {
 }
 
 void ThreadContext::await_suspend(std::coroutine_handle<> awaiter) noexcept {
-    d->mContext = std::make_unique<ContextHelper>(awaiter, d->mThread);
-    d->mContext->moveToThread(d->mThread);
-    qCoro(d->mThread).waitForStarted().then([this]() {
-        auto *event = new QEvent(static_cast<QEvent::Type>(detail::ContextHelper::eventType));
-        QCoreApplication::postEvent(d->mContext.get(), event);
-    });
+    // The shared executor of the thread queues the coroutine even if the thread hasn't
+    // started yet, it gets resumed once the thread's event loop starts.
+    mNode.coroutine = awaiter;
+    ThreadExecutor::forThread(mThread).post(mNode);
 }
 
 void ThreadContext::await_resume() noexcept {}
 
-
 ThreadContext QCoro::moveToThread(QThread *thread) {
     return ThreadContext(thread);
 }
@@ -111,4 +65,3 @@ QCoro::Task<bool> QCoroThread::waitForFinished(std::chrono::milliseconds timeout
     co_return result.has_value();
 }
 
-#include "qcorothread.moc"
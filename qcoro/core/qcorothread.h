@@ -8,6 +8,7 @@
 
 #include "qcorocore_export.h"
 #include "qcoro/coroutine.h"
+#include "qcoro/qcoroexecutor.h"
 
 #include <chrono>
 
@@ -17,10 +18,6 @@ namespace QCoro {
 template<typename T>
 class Task;
 
-namespace detail {
-class ThreadContextPrivate;
-} // namespace detail
-
 class ThreadContext {
 public:
     explicit ThreadContext(QThread *thread);
@@ -41,7 +38,8 @@ public:
     void await_resume() noexcept;
 
 private:
-    std::unique_ptr<detail::ThreadContextPrivate> d;
+    QThread *mThread;
+    detail::ScheduledCoroutine mNode;
 };
 
 ThreadContext moveToThread(QThread *thread);
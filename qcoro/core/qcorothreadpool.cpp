@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorothreadpool.h"
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace QCoro;
+using namespace QCoro::detail;
+
+namespace QCoro::detail {
+
+class ThreadPoolPrivate {
+public:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<ScheduledCoroutine *> queue;
+        std::thread thread;
+    };
+
+    //! Identifies the pool and the worker running in the current thread, if any.
+    struct CurrentWorker {
+        const ThreadPoolPrivate *pool = nullptr;
+        std::size_t index = 0;
+    };
+
+    explicit ThreadPoolPrivate(std::size_t threadCount)
+        : mWorkers(threadCount)
+    {
+        for (std::size_t i = 0; i < mWorkers.size(); ++i) {
+            mWorkers[i].thread = std::thread([this, i]() { run(i); });
+        }
+    }
+
+    ~ThreadPoolPrivate() {
+        {
+            std::lock_guard lock(mSleepMutex);
+            mStopping = true;
+        }
+        mSleepCondition.notify_all();
+        for (auto &worker : mWorkers) {
+            worker.thread.join();
+        }
+    }
+
+    static CurrentWorker &currentWorker() noexcept {
+        static thread_local CurrentWorker current;
+        return current;
+    }
+
+    void post(ScheduledCoroutine &node) {
+        const auto &current = currentWorker();
+        const auto index = current.pool == this
+            ? current.index
+            : mNextWorker.fetch_add(1, std::memory_order_relaxed) % mWorkers.size();
+
+        // Pairs with the sleeping worker incrementing mSleepingWorkers before checking mPending,
+        // so either we see the sleeping worker, or the worker sees the new coroutine.
+        mPending.fetch_add(1, std::memory_order_seq_cst);
+        {
+            auto &worker = mWorkers[index];
+            std::lock_guard lock(worker.mutex);
+            worker.queue.push_back(&node);
+        }
+
+        if (mSleepingWorkers.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard lock(mSleepMutex);
+            mSleepCondition.notify_one();
+        }
+    }
+
+    std::vector<Worker> mWorkers;
+
+private:
+    void run(std::size_t index) {
+        currentWorker() = CurrentWorker{this, index};
+
+        while (true) {
+            if (auto *node = popLocal(index); node != nullptr) {
+                resume(node);
+                continue;
+            }
+            if (auto *node = steal(index); node != nullptr) {
+                resume(node);
+                continue;
+            }
+
+            std::unique_lock lock(mSleepMutex);
+            mSleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+            mSleepCondition.wait(lock, [this]() {
+                return mPending.load(std::memory_order_seq_cst) > 0 || mStopping;
+            });
+            mSleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+            if (mStopping && mPending.load(std::memory_order_seq_cst) == 0) {
+                return;
+            }
+        }
+    }
+
+    void resume(ScheduledCoroutine *node) {
+        mPending.fetch_sub(1, std::memory_order_relaxed);
+        node->coroutine.resume();
+    }
+
+    //! Takes the most recently queued coroutine from the worker's own queue.
+    ScheduledCoroutine *popLocal(std::size_t index) {
+        auto &worker = mWorkers[index];
+        std::lock_guard lock(worker.mutex);
+        if (worker.queue.empty()) {
+            return nullptr;
+        }
+        auto *node = worker.queue.back();
+        worker.queue.pop_back();
+        return node;
+    }
+
+    //! Takes the oldest queued coroutine from any of the other workers.
+    ScheduledCoroutine *steal(std::size_t thief) {
+        for (std::size_t i = 1; i < mWorkers.size(); ++i) {
+            auto &victim = mWorkers[(thief + i) % mWorkers.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.queue.empty()) {
+                auto *node = victim.queue.front();
+                victim.queue.pop_front();
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    std::atomic<std::size_t> mNextWorker{0};
+    std::atomic<std::size_t> mPending{0};
+    std::atomic<std::size_t> mSleepingWorkers{0};
+    std::mutex mSleepMutex;
+    std::condition_variable mSleepCondition;
+    bool mStopping = false;
+};
+
+} // namespace QCoro::detail
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+    : d(std::make_unique<ThreadPoolPrivate>(
+          threadCount > 0 ? threadCount : std::max<std::size_t>(std::thread::hardware_concurrency(), 1)))
+{}
+
+ThreadPool::~ThreadPool() {
+    Q_ASSERT(!isWorkerThread());
+}
+
+std::size_t ThreadPool::threadCount() const noexcept {
+    return d->mWorkers.size();
+}
+
+bool ThreadPool::isWorkerThread() const noexcept {
+    return ThreadPoolPrivate::currentWorker().pool == d.get();
+}
+
+void ThreadPool::post(ScheduledCoroutine &node) noexcept {
+    d->post(node);
+}
@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorocore_export.h"
+#include "qcoro/qcoroexecutor.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace QCoro {
+
+namespace detail {
+class ThreadPoolPrivate;
+} // namespace detail
+
+//! Executor that resumes coroutines on a pool of worker threads.
+/*!
+ * Each worker has its own queue of scheduled coroutines. Coroutines scheduled from a worker
+ * thread are queued to that worker and the worker resumes the most recently queued one first,
+ * while it's still hot in the cache. Coroutines scheduled from other threads are distributed
+ * among the workers in a round-robin fashion. A worker that runs out of coroutines steals the
+ * oldest queued coroutine from another worker before going to sleep.
+ *
+ * The worker threads do not run a Qt event loop, the pool is meant for CPU-bound work. To get
+ * back to a thread with an event loop, `co_await` the schedule() of that thread's ThreadExecutor.
+ *
+ * ```cpp
+ * auto &origin = QCoro::ThreadExecutor::current();
+ * co_await pool.schedule();
+ * const auto result = heavyComputation();
+ * co_await origin.schedule();
+ * ```
+ */
+class QCOROCORE_EXPORT ThreadPool final : public Executor {
+public:
+    //! Creates a pool with the given number of worker threads.
+    /*!
+     * If \c threadCount is 0, the pool creates one worker per CPU core.
+     */
+    explicit ThreadPool(std::size_t threadCount = 0);
+
+    //! Destroys the pool.
+    /*!
+     * Waits for the workers to resume all coroutines that have already been scheduled,
+     * so it must not be called from one of the pool's worker threads.
+     */
+    ~ThreadPool() override;
+
+    //! Returns the number of worker threads.
+    std::size_t threadCount() const noexcept;
+
+    //! Returns whether the calling thread is one of this pool's workers.
+    bool isWorkerThread() const noexcept;
+
+    void post(detail::ScheduledCoroutine &node) noexcept override;
+
+private:
+    std::unique_ptr<detail::ThreadPoolPrivate> d;
+};
+
+} // namespace QCoro
@@ -42,3 +42,73 @@ QCoro::Task<> QCoroTimer::waitForTimeout() const {
     }
 }
 
+QCoro::Task<bool> QCoroTimer::waitForTimeout(QCoro::CancellationToken cancellationToken) const {
+    if (!mTimer || !mTimer->isActive()) {
+        co_return true;
+    }
+
+    const auto timedOut = co_await qCoro(mTimer.data(), &QTimer::timeout, cancellationToken);
+    if (!timedOut.has_value() && cancellationToken.isCancellationRequested()) {
+        if (mTimer) {
+            mTimer->stop();
+        }
+        co_return false;
+    }
+    co_return true;
+}
+
+SleepOperation::SleepOperation(TimerWheel::Clock::time_point deadline, QCoro::CancellationToken cancellationToken)
+    : mDeadline(deadline)
+    , mCancellationToken(std::move(cancellationToken)) {}
+
+SleepOperation::SleepOperation(SleepOperation &&other) noexcept
+    : mDeadline(other.mDeadline)
+    , mCancellationToken(std::move(other.mCancellationToken)) {
+    Q_ASSERT(!other.mAwaitingCoroutine);
+}
+
+bool SleepOperation::await_ready() noexcept {
+    mCancelled = mCancellationToken.isCancellationRequested();
+    return mCancelled;
+}
+
+void SleepOperation::await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+    mAwaitingCoroutine = awaitingCoroutine;
+    if (mDeadline <= TimerWheel::Clock::now()) {
+        // Like a zero-interval QTimer, a sleep whose deadline has passed still yields to the event loop once
+        mResumed.store(true, std::memory_order_relaxed);
+        mResumeNode.coroutine = awaitingCoroutine;
+        ThreadExecutor::current().post(mResumeNode);
+        return;
+    }
+    mTimeout.callback = &SleepOperation::timedOut;
+    mTimeout.operation = this;
+    TimerWheel::current().add(mTimeout, mDeadline);
+    if (mCancellationToken.canBeCancelled()) {
+        mExecutor = &ThreadExecutor::current();
+        mCancellationCallback.emplace(mCancellationToken, CancelRequest{this});
+    }
+}
+
+bool SleepOperation::await_resume() {
+    // Waits for the cancellation callback, in case it's just being invoked from another thread
+    mCancellationCallback.reset();
+    mTimeout.cancel();
+    return !mCancelled;
+}
+
+void SleepOperation::timedOut(TimerEntry *entry) {
+    auto *operation = static_cast<Timeout *>(entry)->operation;
+    if (!operation->mResumed.exchange(true, std::memory_order_acq_rel)) {
+        operation->mAwaitingCoroutine.resume();
+    }
+}
+
+void SleepOperation::CancelRequest::operator()() const {
+    if (!operation->mResumed.exchange(true, std::memory_order_acq_rel)) {
+        // Resume the coroutine from its own thread, where it also cancels the timeout.
+        operation->mCancelled = true;
+        operation->mResumeNode.coroutine = operation->mAwaitingCoroutine;
+        operation->mExecutor->post(operation->mResumeNode);
+    }
+}
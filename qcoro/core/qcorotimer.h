@@ -5,12 +5,18 @@
 #pragma once
 
 #include "qcorotask.h"
+#include "qcorocancellationtoken.h"
+#include "qcoroexecutor.h"
 #include "qcorocore_export.h"
+#include "impl/timerwheel.h"
 
 #include <QMetaObject>
 #include <QPointer>
 #include <QTimer>
 
+#include <atomic>
+#include <optional>
+
 /*! \cond internal */
 
 namespace QCoro::detail {
@@ -38,6 +44,56 @@ public:
     explicit QCoroTimer(QTimer *timer);
 
     Task<void> waitForTimeout() const;
+
+    //! Waits for the timer to time out, unless cancelled.
+    /*!
+     * If cancellation is requested through the \c cancellationToken before the timer times out,
+     * the timer is stopped.
+     *
+     * \return Returns \c true if the timer has timed out, \c false if the wait was cancelled.
+     */
+    Task<bool> waitForTimeout(QCoro::CancellationToken cancellationToken) const;
+};
+
+//! Suspends the awaiting coroutine until the deadline, using the thread's TimerWheel.
+class QCOROCORE_EXPORT SleepOperation {
+public:
+    explicit SleepOperation(TimerWheel::Clock::time_point deadline,
+                            QCoro::CancellationToken cancellationToken = {});
+    SleepOperation(const SleepOperation &) = delete;
+    //! The operation must not be moved once it's been suspended.
+    SleepOperation(SleepOperation &&other) noexcept;
+    SleepOperation &operator=(const SleepOperation &) = delete;
+    SleepOperation &operator=(SleepOperation &&) = delete;
+
+    bool await_ready() noexcept;
+    void await_suspend(std::coroutine_handle<> awaitingCoroutine);
+    //! Returns \c true if the deadline has been reached, \c false if the sleep has been cancelled.
+    bool await_resume();
+
+private:
+    //! Invoked when cancellation is requested, possibly from a different thread.
+    struct CancelRequest {
+        void operator()() const;
+        SleepOperation *operation;
+    };
+
+    struct Timeout : TimerEntry {
+        SleepOperation *operation = nullptr;
+    };
+
+    static void timedOut(TimerEntry *entry);
+
+    TimerWheel::Clock::time_point mDeadline;
+    QCoro::CancellationToken mCancellationToken;
+    std::coroutine_handle<> mAwaitingCoroutine;
+    Timeout mTimeout;
+    //! Set by whichever of the timeout and the cancellation resumes the coroutine first.
+    std::atomic<bool> mResumed{false};
+    bool mCancelled = false;
+    ThreadExecutor *mExecutor = nullptr;
+    ScheduledCoroutine mResumeNode;
+    std::optional<QCoro::CancellationCallback<CancelRequest>> mCancellationCallback;
 };
 
 template<>
@@ -55,12 +111,23 @@ struct awaiter_type<QTimer> {
 namespace QCoro {
 
 //! A coroutine that suspends for given period of time.
+/*!
+ * The coroutine is resumed by the per-thread timer wheel, which drives all QCoro timeouts in
+ * the thread with a single timer, so sleeping doesn't create a QTimer.
+ */
 template<typename Rep, typename Period>
 QCoro::Task<> sleepFor(const std::chrono::duration<Rep, Period> &timeout) {
-    QTimer timer;
-    timer.setSingleShot(true);
-    timer.start(std::chrono::duration_cast<std::chrono::milliseconds>(timeout));
-    co_await timer;
+    co_await detail::SleepOperation{detail::TimerWheel::deadlineAfter(timeout)};
+}
+
+//! A coroutine that suspends for given period of time, unless cancelled.
+/*!
+ * \return Returns \c true if the whole period has elapsed, \c false if cancellation was
+ * requested through the \c cancellationToken before that.
+ */
+template<typename Rep, typename Period>
+QCoro::Task<bool> sleepFor(const std::chrono::duration<Rep, Period> &timeout, QCoro::CancellationToken cancellationToken) {
+    co_return co_await detail::SleepOperation{detail::TimerWheel::deadlineAfter(timeout), std::move(cancellationToken)};
 }
 
 //! A coroutine that suspends until the specified time.
@@ -70,6 +137,17 @@ QCoro::Task<> sleepUntil(const std::chrono::time_point<Clock, Duration> &when) {
     return sleepFor(tp);
 }
 
+//! A coroutine that suspends until the specified time, unless cancelled.
+/*!
+ * \return Returns \c true if the specified time has been reached, \c false if cancellation was
+ * requested through the \c cancellationToken before that.
+ */
+template<typename Clock, typename Duration>
+QCoro::Task<bool> sleepUntil(const std::chrono::time_point<Clock, Duration> &when, QCoro::CancellationToken cancellationToken) {
+    const auto tp = when.time_since_epoch() - std::chrono::steady_clock::now().time_since_epoch();
+    return sleepFor(tp, std::move(cancellationToken));
+}
+
 } // namespace QCoro
 
 /*! \endcond */
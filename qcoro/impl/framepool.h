@@ -0,0 +1,236 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+ * Do NOT include this file directly - include the QCoroTask header instead!
+ */
+
+#pragma once
+
+#include "../qcorotask.h"
+#include "qcoro/config.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace QCoro
+{
+
+inline double FramePoolStatistics::hitRate() const noexcept {
+    return allocations == 0 ? 0.0 : static_cast<double>(poolHits) / static_cast<double>(allocations);
+}
+
+namespace detail
+{
+
+//! Allocates coroutine frames for Task and LazyTask.
+/*!
+ * Every frame is followed by a pointer to the function that knows how to deallocate it,
+ * and, for frames allocated by a user-supplied allocator, by a copy of the allocator.
+ * This way the promise's operator delete, which only receives the pointer and the size
+ * of the frame, can always release the frame correctly.
+ *
+ * Frames allocated without a user-supplied allocator are served from a small per-thread
+ * pool of recently released frames, split into size classes.
+ */
+class FrameAllocator {
+public:
+    using DeallocateFn = void (*)(void *frame, std::size_t frameSize) noexcept;
+
+    static void *allocate(std::size_t frameSize);
+
+    template<typename Allocator>
+    static void *allocate(std::size_t frameSize, const Allocator &allocator);
+
+    static void deallocate(void *frame, std::size_t frameSize) noexcept;
+
+    static FramePoolStatistics statistics() noexcept;
+    static void resetStatistics() noexcept;
+
+private:
+    //! Size classes are multiples of this, frames larger than the largest class bypass the pool.
+    static constexpr std::size_t sizeClassGranularity = 64;
+    static constexpr std::size_t sizeClassCount = 32;
+    //! Maximum number of frames cached per size class, to bound memory held by an idle thread.
+    static constexpr std::size_t maxCachedFramesPerClass = 32;
+
+    struct FreeFrame {
+        FreeFrame *next;
+    };
+
+    //! Per-thread pool state. Trivially destructible, so that it remains usable even
+    //! after the PoolCleanup below has been destroyed during thread exit.
+    struct PoolState {
+        std::array<FreeFrame *, sizeClassCount> freeFrames;
+        std::array<std::size_t, sizeClassCount> cachedFrames;
+        FramePoolStatistics statistics;
+        bool cleanupRegistered;
+        bool threadExiting;
+    };
+
+    //! Releases all cached frames when the thread exits.
+    struct PoolCleanup {
+        ~PoolCleanup();
+    };
+
+    //! Block used for allocating frames via a user-supplied allocator, to get suitably aligned memory.
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) AlignedBlock {
+        std::byte data[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+    };
+
+    static constexpr std::size_t alignUp(std::size_t size, std::size_t alignment) noexcept {
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+    static constexpr std::size_t deallocateFnOffset(std::size_t frameSize) noexcept {
+        return alignUp(frameSize, alignof(DeallocateFn));
+    }
+
+    static constexpr std::size_t pooledSize(std::size_t frameSize) noexcept {
+        return deallocateFnOffset(frameSize) + sizeof(DeallocateFn);
+    }
+
+    template<typename Allocator>
+    static constexpr std::size_t allocatorOffset(std::size_t frameSize) noexcept {
+        return alignUp(pooledSize(frameSize), alignof(Allocator));
+    }
+
+    template<typename Allocator>
+    static constexpr std::size_t allocatorBlockCount(std::size_t frameSize) noexcept {
+        return alignUp(allocatorOffset<Allocator>(frameSize) + sizeof(Allocator), sizeof(AlignedBlock)) / sizeof(AlignedBlock);
+    }
+
+    static DeallocateFn &deallocateFn(void *frame, std::size_t frameSize) noexcept {
+        return *reinterpret_cast<DeallocateFn *>(static_cast<std::byte *>(frame) + deallocateFnOffset(frameSize));
+    }
+
+    static PoolState &poolState() noexcept;
+    static void registerCleanup() noexcept;
+
+    static void deallocatePooled(void *frame, std::size_t frameSize) noexcept;
+
+    template<typename Allocator>
+    static void deallocateWithAllocator(void *frame, std::size_t frameSize) noexcept;
+};
+
+inline FrameAllocator::PoolState &FrameAllocator::poolState() noexcept {
+    // Constant-initialized and trivially destructible, so there's no guard and no destructor.
+    static thread_local PoolState state{};
+    return state;
+}
+
+inline void FrameAllocator::registerCleanup() noexcept {
+    // The first odr-use of the thread_local object registers its destructor for the current thread.
+    static thread_local PoolCleanup cleanup;
+    static_cast<void>(cleanup);
+    poolState().cleanupRegistered = true;
+}
+
+inline FrameAllocator::PoolCleanup::~PoolCleanup() {
+    auto &state = poolState();
+    state.threadExiting = true;
+    for (std::size_t sizeClass = 0; sizeClass < sizeClassCount; ++sizeClass) {
+        while (auto *frame = state.freeFrames[sizeClass]) {
+            state.freeFrames[sizeClass] = frame->next;
+            ::operator delete(frame);
+        }
+        state.cachedFrames[sizeClass] = 0;
+    }
+}
+
+inline void *FrameAllocator::allocate(std::size_t frameSize) {
+    auto &state = poolState();
+    ++state.statistics.allocations;
+
+    const auto size = pooledSize(frameSize);
+    const auto sizeClass = (size - 1) / sizeClassGranularity;
+    void *frame = nullptr;
+#ifndef QCORO_NO_FRAME_POOL
+    if (sizeClass < sizeClassCount && state.freeFrames[sizeClass] != nullptr) {
+        auto *freeFrame = state.freeFrames[sizeClass];
+        state.freeFrames[sizeClass] = freeFrame->next;
+        --state.cachedFrames[sizeClass];
+        ++state.statistics.poolHits;
+        frame = freeFrame;
+    } else
+#endif
+    if (sizeClass < sizeClassCount) {
+        // Always allocate the whole size class, so that the frame can be reused for any other
+        // frame of the same class later.
+        frame = ::operator new((sizeClass + 1) * sizeClassGranularity);
+    } else {
+        frame = ::operator new(size);
+    }
+
+    deallocateFn(frame, frameSize) = &FrameAllocator::deallocatePooled;
+    return frame;
+}
+
+template<typename Allocator>
+inline void *FrameAllocator::allocate(std::size_t frameSize, const Allocator &allocator) {
+    using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<AlignedBlock>;
+    using StoredAllocator = BlockAllocator;
+
+    BlockAllocator blockAllocator(allocator);
+    void *frame = std::allocator_traits<BlockAllocator>::allocate(blockAllocator, allocatorBlockCount<StoredAllocator>(frameSize));
+    deallocateFn(frame, frameSize) = &FrameAllocator::deallocateWithAllocator<StoredAllocator>;
+    ::new (static_cast<std::byte *>(frame) + allocatorOffset<StoredAllocator>(frameSize)) StoredAllocator(std::move(blockAllocator));
+    return frame;
+}
+
+inline void FrameAllocator::deallocate(void *frame, std::size_t frameSize) noexcept {
+    deallocateFn(frame, frameSize)(frame, frameSize);
+}
+
+inline void FrameAllocator::deallocatePooled(void *frame, std::size_t frameSize) noexcept {
+    auto &state = poolState();
+    ++state.statistics.deallocations;
+
+    const auto sizeClass = (pooledSize(frameSize) - 1) / sizeClassGranularity;
+#ifndef QCORO_NO_FRAME_POOL
+    if (sizeClass < sizeClassCount && !state.threadExiting && state.cachedFrames[sizeClass] < maxCachedFramesPerClass) {
+        if (!state.cleanupRegistered) {
+            registerCleanup();
+        }
+        auto *freeFrame = ::new (frame) FreeFrame{state.freeFrames[sizeClass]};
+        state.freeFrames[sizeClass] = freeFrame;
+        ++state.cachedFrames[sizeClass];
+        return;
+    }
+#else
+    static_cast<void>(sizeClass);
+#endif
+
+    ::operator delete(frame);
+}
+
+template<typename Allocator>
+inline void FrameAllocator::deallocateWithAllocator(void *frame, std::size_t frameSize) noexcept {
+    auto *storedAllocator = std::launder(reinterpret_cast<Allocator *>(static_cast<std::byte *>(frame) + allocatorOffset<Allocator>(frameSize)));
+    Allocator allocator(std::move(*storedAllocator));
+    storedAllocator->~Allocator();
+    std::allocator_traits<Allocator>::deallocate(allocator, static_cast<AlignedBlock *>(frame), allocatorBlockCount<Allocator>(frameSize));
+}
+
+inline FramePoolStatistics FrameAllocator::statistics() noexcept {
+    return poolState().statistics;
+}
+
+inline void FrameAllocator::resetStatistics() noexcept {
+    poolState().statistics = {};
+}
+
+} // namespace detail
+
+inline FramePoolStatistics framePoolStatistics() noexcept {
+    return detail::FrameAllocator::statistics();
+}
+
+inline void resetFramePoolStatistics() noexcept {
+    detail::FrameAllocator::resetStatistics();
+}
+
+} // namespace QCoro
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+ * Do NOT include this file directly - include the QCoroChannel header instead!
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace QCoro::detail
+{
+
+//! Size of a cache line, used to keep the producer and consumer positions apart.
+inline constexpr std::size_t cacheLineSize = 64;
+
+//! Fixed-capacity lock-free ring buffer for a single producer and a single consumer.
+/*!
+ * Only one thread may push and only one thread may pop at a time. A different thread may
+ * take over either role, as long as it's synchronized with the previous one.
+ */
+template<typename T>
+class SpscRingBuffer {
+public:
+    explicit SpscRingBuffer(std::size_t capacity)
+        : mCapacity(capacity)
+        , mCells(std::make_unique<std::optional<T>[]>(capacity))
+    {
+        Q_ASSERT(capacity > 0);
+    }
+
+    std::size_t capacity() const noexcept {
+        return mCapacity;
+    }
+
+    //! Moves the \c value into the buffer, unless it's full, in which case the \c value is left untouched.
+    bool tryPush(T &value) {
+        const auto tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mHead.load(std::memory_order_acquire) == mCapacity) {
+            return false;
+        }
+        mCells[tail % mCapacity].emplace(std::move(value));
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> tryPop() {
+        const auto head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        auto &cell = mCells[head % mCapacity];
+        std::optional<T> value{std::move(*cell)};
+        cell.reset();
+        mHead.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    //! Returns the number of values in the buffer. Only an estimate while the buffer is being used.
+    std::size_t size() const noexcept {
+        return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire);
+    }
+
+private:
+    const std::size_t mCapacity;
+    std::unique_ptr<std::optional<T>[]> mCells;
+    alignas(cacheLineSize) std::atomic<std::size_t> mHead{0};
+    alignas(cacheLineSize) std::atomic<std::size_t> mTail{0};
+};
+
+//! Fixed-capacity lock-free ring buffer for any number of producers and consumers.
+/*!
+ * Each cell carries a sequence number that tells whether it's ready to be written to or read
+ * from in the current lap around the buffer: the cell for position \c p is free when its sequence
+ * is `2 * p` and holds a value when it's `2 * p + 1`. Producers and consumers claim cells by
+ * advancing their position with a CAS and never wait for each other, except that a consumer
+ * treats a cell claimed but not yet written by a producer as empty.
+ */
+template<typename T>
+class MpmcRingBuffer {
+public:
+    explicit MpmcRingBuffer(std::size_t capacity)
+        : mCapacity(capacity)
+        , mCells(std::make_unique<Cell[]>(capacity))
+    {
+        Q_ASSERT(capacity > 0);
+        for (std::size_t i = 0; i < capacity; ++i) {
+            mCells[i].sequence.store(2 * i, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t capacity() const noexcept {
+        return mCapacity;
+    }
+
+    //! Moves the \c value into the buffer, unless it's full, in which case the \c value is left untouched.
+    bool tryPush(T &value) {
+        auto position = mTail.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        while (true) {
+            cell = &mCells[position % mCapacity];
+            const auto sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(2 * position);
+            if (diff == 0) {
+                if (mTail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // The cell still holds a value from the previous lap
+            } else {
+                position = mTail.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value.emplace(std::move(value));
+        cell->sequence.store(2 * position + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> tryPop() {
+        auto position = mHead.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        while (true) {
+            cell = &mCells[position % mCapacity];
+            const auto sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(2 * position + 1);
+            if (diff == 0) {
+                if (mHead.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return std::nullopt; // The cell has not been written in this lap yet
+            } else {
+                position = mHead.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::optional<T> value{std::move(*cell->value)};
+        cell->value.reset();
+        cell->sequence.store(2 * (position + mCapacity), std::memory_order_release);
+        return value;
+    }
+
+    //! Returns the number of values in the buffer. Only an estimate while the buffer is being used.
+    std::size_t size() const noexcept {
+        const auto head = mHead.load(std::memory_order_acquire);
+        const auto tail = mTail.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        std::optional<T> value;
+    };
+
+    const std::size_t mCapacity;
+    std::unique_ptr<Cell[]> mCells;
+    alignas(cacheLineSize) std::atomic<std::size_t> mHead{0};
+    alignas(cacheLineSize) std::atomic<std::size_t> mTail{0};
+};
+
+} // namespace QCoro::detail
@@ -10,27 +10,50 @@
 
 #include "../qcorotask.h"
 
+#include <iterator>
+#include <utility>
+
 namespace QCoro::detail
 {
 
-inline TaskFinalSuspend::TaskFinalSuspend(const std::vector<std::coroutine_handle<>> &awaitingCoroutines)
-    : mAwaitingCoroutines(awaitingCoroutines) {}
-
 inline bool TaskFinalSuspend::await_ready() const noexcept {
     return false;
 }
 
 template<typename Promise>
-inline void TaskFinalSuspend::await_suspend(std::coroutine_handle<Promise> finishedCoroutine) noexcept {
+inline std::coroutine_handle<> TaskFinalSuspend::await_suspend(std::coroutine_handle<Promise> finishedCoroutine) noexcept {
     auto &promise = finishedCoroutine.promise();
 
-    for (auto &awaiter : mAwaitingCoroutines) {
-        awaiter.resume();
+    if (!promise.mAwaitingCoroutine) {
+        // The handle will be destroyed here only if the associated Task has already been destroyed
+        promise.derefCoroutine();
+        return std::noop_coroutine();
+    }
+
+    // Resume all but the last awaiter directly, the last one is resumed via symmetric
+    // transfer, so that a chain of coroutines doesn't nest a stack frame per each link.
+    auto next = std::exchange(promise.mAwaitingCoroutine, nullptr);
+    if (!promise.mAdditionalAwaitingCoroutines.empty()) {
+        const auto additionalAwaiters = std::move(promise.mAdditionalAwaitingCoroutines);
+        next.resume();
+        for (auto it = additionalAwaiters.cbegin(), end = std::prev(additionalAwaiters.cend()); it != end; ++it) {
+            it->resume();
+        }
+        next = additionalAwaiters.back();
+    }
+
+    if (--promise.mRefCount == 0) {
+        // The associated Task has already been destroyed, so nothing keeps the frame alive
+        // while the last awaiter retrieves the result. Resume it the old-fashioned way and
+        // only destroy the frame afterwards.
+        next.resume();
+        promise.destroyCoroutine();
+        return std::noop_coroutine();
     }
-    mAwaitingCoroutines.clear();
 
-    // The handle will be destroyed here only if the associated Task has already been destroyed
-    promise.derefCoroutine();
+    // The frame is kept alive by the Task, which will destroy it once it's gone. This object lives
+    // in the coroutine frame, so it must not be accessed past this point.
+    return next;
 }
 
 constexpr void TaskFinalSuspend::await_resume() const noexcept {}
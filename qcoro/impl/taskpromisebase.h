@@ -24,7 +24,7 @@ inline std::suspend_never TaskPromiseBase::initial_suspend() const noexcept {
 }
 
 inline auto TaskPromiseBase::final_suspend() const noexcept {
-    return TaskFinalSuspend{mAwaitingCoroutines};
+    return TaskFinalSuspend{};
 }
 
 template<typename T, typename Awaiter>
@@ -43,11 +43,15 @@ inline auto &TaskPromiseBase::await_transform(T &awaitable) {
 }
 
 inline void TaskPromiseBase::addAwaitingCoroutine(std::coroutine_handle<> awaitingCoroutine) {
-    mAwaitingCoroutines.push_back(awaitingCoroutine);
+    if (!mAwaitingCoroutine) {
+        mAwaitingCoroutine = awaitingCoroutine;
+    } else {
+        mAdditionalAwaitingCoroutines.push_back(awaitingCoroutine);
+    }
 }
 
 inline bool TaskPromiseBase::hasAwaitingCoroutine() const {
-    return !mAwaitingCoroutines.empty();
+    return static_cast<bool>(mAwaitingCoroutine);
 }
 
 inline void TaskPromiseBase::derefCoroutine() {
@@ -66,4 +70,22 @@ inline void TaskPromiseBase::destroyCoroutine() {
     handle.destroy();
 }
 
+inline void *TaskPromiseBase::operator new(std::size_t size) {
+    return FrameAllocator::allocate(size);
+}
+
+template<typename Allocator, typename ... Args>
+inline void *TaskPromiseBase::operator new(std::size_t size, std::allocator_arg_t, const Allocator &allocator, const Args & ...) {
+    return FrameAllocator::allocate(size, allocator);
+}
+
+template<typename This, typename Allocator, typename ... Args>
+inline void *TaskPromiseBase::operator new(std::size_t size, const This &, std::allocator_arg_t, const Allocator &allocator, const Args & ...) {
+    return FrameAllocator::allocate(size, allocator);
+}
+
+inline void TaskPromiseBase::operator delete(void *ptr, std::size_t size) noexcept {
+    FrameAllocator::deallocate(ptr, size);
+}
+
 } // namespace QCoro::detail
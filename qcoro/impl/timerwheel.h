@@ -0,0 +1,339 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+ * Do NOT include this file directly - it's used by awaitables with a timeout
+ * and by the QCoroTimer header.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QTimerEvent>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <utility>
+
+namespace QCoro::detail {
+
+class TimerWheel;
+
+//! A timeout scheduled in the TimerWheel of the awaiting thread.
+/*!
+ * The entry is embedded in the awaiter, so scheduling a timeout doesn't allocate. Destroying
+ * a scheduled entry cancels it. A scheduled entry must not be moved, moving an unscheduled
+ * entry only moves its callback.
+ */
+struct TimerEntry {
+    TimerEntry() = default;
+    TimerEntry(const TimerEntry &) = delete;
+    TimerEntry &operator=(const TimerEntry &) = delete;
+
+    TimerEntry(TimerEntry &&other) noexcept
+        : callback(other.callback) {
+        Q_ASSERT(!other.isScheduled());
+    }
+
+    TimerEntry &operator=(TimerEntry &&other) noexcept {
+        Q_ASSERT(!isScheduled() && !other.isScheduled());
+        callback = other.callback;
+        return *this;
+    }
+
+    ~TimerEntry() {
+        cancel();
+    }
+
+    bool isScheduled() const noexcept {
+        return wheel != nullptr;
+    }
+
+    //! Unschedules the entry, unless it has expired already.
+    void cancel() noexcept;
+
+    //! Invoked in the wheel's thread when the entry expires, the entry is already unscheduled.
+    void (*callback)(TimerEntry *entry) = nullptr;
+
+private:
+    friend class TimerWheel;
+
+    //! The wheel in which the entry is scheduled, \c nullptr if it's not scheduled.
+    TimerWheel *wheel = nullptr;
+    std::uint64_t expiry = 0;
+    std::uint16_t slot = 0;
+    TimerEntry *next = nullptr;
+    //! The pointer that points to this entry, either a slot or the previous entry's \c next.
+    TimerEntry **link = nullptr;
+};
+
+//! Per-thread hierarchical hashed timer wheel driving all QCoro timeouts in the thread.
+/*!
+ * The wheel counts time in milliseconds since its creation. Each of its levels has 64 slots,
+ * a slot of level N covers 64^N milliseconds. An entry is placed on the level of the highest
+ * 6-bit digit in which its expiry differs from the current time, so scheduling and cancelling
+ * an entry is O(1) regardless of how many entries are scheduled. When the current time reaches
+ * a slot of a higher level, its entries are cascaded to the lower levels, level 0 entries expire.
+ *
+ * A single Qt timer is armed to the start of the earliest occupied slot, found through a bitmap
+ * of occupied slots of each level, so an idle wheel doesn't tick.
+ *
+ * All methods must be called from the wheel's thread.
+ */
+class TimerWheel final : public QObject {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    ~TimerWheel() override {
+        // Awaiters that outlive the thread's wheel must not touch it anymore
+        for (auto &head : mSlots) {
+            for (auto *entry = head; entry != nullptr; entry = entry->next) {
+                entry->wheel = nullptr;
+            }
+        }
+    }
+
+    //! Returns the wheel of the current thread.
+    static TimerWheel &current() {
+        static thread_local TimerWheel wheel;
+        return wheel;
+    }
+
+    //! Schedules the \c entry to expire at \c deadline.
+    void add(TimerEntry &entry, Clock::time_point deadline) {
+        Q_ASSERT(!entry.isScheduled());
+        Q_ASSERT(entry.callback != nullptr);
+        if (mCount == 0) {
+            // Nothing is scheduled, skip the idle time rather than cascading through it later
+            mCurrentTick = std::max(mCurrentTick, tickAt(Clock::now()));
+        }
+
+        entry.wheel = this;
+        entry.expiry = std::max(expiryTick(deadline), mCurrentTick + 1);
+        ++mCount;
+        const auto eventTick = place(entry);
+        if (mTimerId == 0 || eventTick < mTimerTick) {
+            armTimer(eventTick);
+        }
+    }
+
+    //! Schedules the \c entry to expire after \c timeout.
+    template<typename Rep, typename Period>
+    void add(TimerEntry &entry, std::chrono::duration<Rep, Period> timeout) {
+        add(entry, deadlineAfter(timeout));
+    }
+
+    //! Unschedules the \c entry, unless it has expired already.
+    void remove(TimerEntry &entry) noexcept {
+        if (entry.wheel != this) {
+            return;
+        }
+        unlink(entry);
+        entry.wheel = nullptr;
+        --mCount;
+        // The timer is left running, if it fires before the next deadline it's simply re-armed.
+    }
+
+    //! Returns the point in time after \c timeout from now, saturated rather than overflowing.
+    template<typename Rep, typename Period>
+    static Clock::time_point deadlineAfter(std::chrono::duration<Rep, Period> timeout) {
+        const auto now = Clock::now();
+        // Compared as floating point, so that converting a huge timeout doesn't overflow
+        using Seconds = std::chrono::duration<double>;
+        if (Seconds{timeout} >= Seconds{Clock::time_point::max() - now}) {
+            return Clock::time_point::max();
+        }
+        return now + std::chrono::ceil<Clock::duration>(timeout);
+    }
+
+    //! Returns the number of scheduled entries.
+    std::size_t size() const noexcept {
+        return mCount;
+    }
+
+protected:
+    void timerEvent(QTimerEvent *event) override {
+        if (event->timerId() != mTimerId) {
+            QObject::timerEvent(event);
+            return;
+        }
+
+        killTimer(mTimerId);
+        mTimerId = 0;
+        advance(tickAt(Clock::now()));
+        if (mCount > 0) {
+            armTimer(nextEventTick());
+        }
+    }
+
+private:
+    static constexpr unsigned int levelBits = 6;
+    static constexpr unsigned int slotsPerLevel = 1U << levelBits;
+    static constexpr unsigned int levels = 6;
+    //! Entries expiring more than 64^levels milliseconds (over two years) ahead.
+    static constexpr std::uint16_t overflowSlot = levels * slotsPerLevel;
+    //! Entries that are due and wait for their callback to be invoked.
+    static constexpr std::uint16_t expiredSlot = overflowSlot + 1;
+
+    TimerWheel()
+        : mOrigin(Clock::now())
+    {}
+
+    std::uint64_t tickAt(Clock::time_point time) const {
+        const auto elapsed = std::chrono::floor<std::chrono::milliseconds>(time - mOrigin).count();
+        return static_cast<std::uint64_t>(std::max<std::int64_t>(elapsed, 0));
+    }
+
+    std::uint64_t expiryTick(Clock::time_point deadline) const {
+        const auto elapsed = std::chrono::ceil<std::chrono::milliseconds>(deadline - mOrigin).count();
+        return static_cast<std::uint64_t>(std::max<std::int64_t>(elapsed, 0));
+    }
+
+    static constexpr std::uint64_t levelSpan(unsigned int level) {
+        return std::uint64_t{1} << (levelBits * level);
+    }
+
+    //! Puts the \c entry into the slot given by its expiry, returns the tick at which the slot is processed.
+    std::uint64_t place(TimerEntry &entry) {
+        if (entry.expiry <= mCurrentTick) {
+            push(entry, expiredSlot);
+            return mCurrentTick;
+        }
+
+        const auto level = (std::bit_width(entry.expiry ^ mCurrentTick) - 1) / levelBits;
+        if (level >= levels) {
+            push(entry, overflowSlot);
+            return overflowTick();
+        }
+
+        const auto index = (entry.expiry >> (levelBits * level)) & (slotsPerLevel - 1);
+        push(entry, static_cast<std::uint16_t>(level * slotsPerLevel + index));
+        mOccupied[level] |= std::uint64_t{1} << index;
+        return slotTick(level, index);
+    }
+
+    //! The tick at which the slot \c index of the \c level is reached.
+    std::uint64_t slotTick(unsigned int level, std::uint64_t index) const {
+        const auto blockStart = mCurrentTick & ~(levelSpan(level + 1) - 1);
+        return blockStart + index * levelSpan(level);
+    }
+
+    //! The tick at which the overflowing entries are placed into the wheel again.
+    std::uint64_t overflowTick() const {
+        const auto span = levelSpan(levels);
+        return (mCurrentTick & ~(span - 1)) + span;
+    }
+
+    //! Returns the earliest tick at which an entry expires or has to be cascaded.
+    std::uint64_t nextEventTick() const {
+        if (mSlots[expiredSlot] != nullptr) {
+            return mCurrentTick;
+        }
+        for (unsigned int level = 0; level < levels; ++level) {
+            // Lower levels always come first, all their slots are within the current slot of this level
+            if (mOccupied[level] != 0) {
+                return slotTick(level, static_cast<std::uint64_t>(std::countr_zero(mOccupied[level])));
+            }
+        }
+        return mSlots[overflowSlot] != nullptr ? overflowTick() : UINT64_MAX;
+    }
+
+    void push(TimerEntry &entry, std::uint16_t slot) {
+        auto &head = mSlots[slot];
+        entry.slot = slot;
+        entry.next = head;
+        entry.link = &head;
+        if (head != nullptr) {
+            head->link = &entry.next;
+        }
+        head = &entry;
+    }
+
+    void unlink(TimerEntry &entry) noexcept {
+        *entry.link = entry.next;
+        if (entry.next != nullptr) {
+            entry.next->link = entry.link;
+        }
+        if (entry.slot < overflowSlot && mSlots[entry.slot] == nullptr) {
+            mOccupied[entry.slot / slotsPerLevel] &= ~(std::uint64_t{1} << (entry.slot % slotsPerLevel));
+        }
+    }
+
+    //! Moves all entries of the \c slot to where they belong at the current tick.
+    void cascade(std::uint16_t slot) {
+        auto *entry = std::exchange(mSlots[slot], nullptr);
+        if (slot < overflowSlot) {
+            mOccupied[slot / slotsPerLevel] &= ~(std::uint64_t{1} << (slot % slotsPerLevel));
+        }
+        while (entry != nullptr) {
+            auto *next = entry->next;
+            place(*entry);
+            entry = next;
+        }
+    }
+
+    //! Expires all entries due at or before \c tick.
+    void advance(std::uint64_t tick) {
+        // Callbacks resume coroutines, which may schedule or cancel other entries, or even run
+        // a nested event loop that advances the wheel, so all state is kept in members.
+        while (true) {
+            if (auto *entry = mSlots[expiredSlot]; entry != nullptr) {
+                remove(*entry);
+                entry->callback(entry);
+                continue;
+            }
+
+            const auto eventTick = nextEventTick();
+            if (eventTick > tick) {
+                break;
+            }
+
+            mCurrentTick = eventTick;
+            if (eventTick % levelSpan(levels) == 0) {
+                cascade(overflowSlot);
+            }
+            // A slot of a higher level is reached when all lower digits of the tick are zero,
+            // its entries are cascaded to lower levels, from the top so that they cascade
+            // further down within this same tick.
+            for (unsigned int level = levels; level-- > 0;) {
+                if (level == 0 || eventTick % levelSpan(level) == 0) {
+                    const auto index = (eventTick >> (levelBits * level)) & (slotsPerLevel - 1);
+                    cascade(static_cast<std::uint16_t>(level * slotsPerLevel + index));
+                }
+            }
+        }
+        mCurrentTick = std::max(mCurrentTick, tick);
+    }
+
+    void armTimer(std::uint64_t tick) {
+        if (mTimerId != 0) {
+            killTimer(mTimerId);
+        }
+        const auto now = tickAt(Clock::now());
+        const auto interval = tick > now ? std::min<std::uint64_t>(tick - now, INT_MAX) : 0;
+        mTimerTick = tick;
+        mTimerId = startTimer(std::chrono::milliseconds{interval}, Qt::CoarseTimer);
+    }
+
+    const Clock::time_point mOrigin;
+    //! All entries expiring at or before this tick have expired.
+    std::uint64_t mCurrentTick = 0;
+    std::size_t mCount = 0;
+    std::array<TimerEntry *, expiredSlot + 1> mSlots = {};
+    std::array<std::uint64_t, levels> mOccupied = {};
+    int mTimerId = 0;
+    std::uint64_t mTimerTick = 0;
+};
+
+inline void TimerEntry::cancel() noexcept {
+    if (wheel != nullptr) {
+        wheel->remove(*this);
+    }
+}
+
+} // namespace QCoro::detail
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+ * Do NOT include this file directly - include the QCoroMutex, QCoroSemaphore, QCoroEvent,
+ * QCoroConditionVariable or QCoroChannel header instead!
+ */
+
+#pragma once
+
+#include "../qcoroexecutor.h"
+
+namespace QCoro::detail
+{
+
+//! A coroutine suspended on a synchronization primitive.
+/*!
+ * The waiter is embedded in the awaiter, so suspending a coroutine on a synchronization
+ * primitive never allocates.
+ */
+struct Waiter {
+    ScheduledCoroutine node;
+    //! Executor that resumes the coroutine, the executor of the waiting thread by default.
+    Executor *executor = nullptr;
+    Waiter *next = nullptr;
+
+    void prepare(std::coroutine_handle<> awaitingCoroutine) noexcept {
+        node.coroutine = awaitingCoroutine;
+        if (executor == nullptr) {
+            executor = &ThreadExecutor::current();
+        }
+    }
+
+    //! Schedules the coroutine to be resumed. The waiter must not be accessed afterwards.
+    void resume() noexcept {
+        executor->post(node);
+    }
+};
+
+//! Intrusive FIFO list of waiters. Not thread-safe, the owner must synchronize access.
+class WaiterList {
+public:
+    bool isEmpty() const noexcept {
+        return mHead == nullptr;
+    }
+
+    void append(Waiter *waiter) noexcept {
+        waiter->next = nullptr;
+        if (mTail != nullptr) {
+            mTail->next = waiter;
+        } else {
+            mHead = waiter;
+        }
+        mTail = waiter;
+    }
+
+    //! Puts a waiter taken by takeFirst() back to the front of the list.
+    void prepend(Waiter *waiter) noexcept {
+        waiter->next = mHead;
+        mHead = waiter;
+        if (mTail == nullptr) {
+            mTail = waiter;
+        }
+    }
+
+    Waiter *takeFirst() noexcept {
+        auto *waiter = mHead;
+        if (waiter != nullptr) {
+            mHead = waiter->next;
+            if (mHead == nullptr) {
+                mTail = nullptr;
+            }
+        }
+        return waiter;
+    }
+
+    //! Removes all waiters from the list and returns the first one, the rest are linked through Waiter::next.
+    Waiter *takeAll() noexcept {
+        auto *waiter = mHead;
+        mHead = nullptr;
+        mTail = nullptr;
+        return waiter;
+    }
+
+    //! Resumes all waiters in a chain returned by takeAll().
+    static void resumeAll(Waiter *waiter) noexcept {
+        while (waiter != nullptr) {
+            // The waiter may be destroyed once it's resumed
+            auto *next = waiter->next;
+            waiter->resume();
+            waiter = next;
+        }
+    }
+
+private:
+    Waiter *mHead = nullptr;
+    Waiter *mTail = nullptr;
+};
+
+} // namespace QCoro::detail
@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+ * Do NOT include this file directly - include the QCoroTask header instead!
+ */
+
+#pragma once
+
+#include "../qcorotask.h"
+
+#include <atomic>
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace QCoro
+{
+
+namespace detail
+{
+
+//! Counts unfinished coroutines and resumes the awaiting coroutine once all of them have finished.
+/*!
+ * The counter starts with one extra reference held by the awaiting coroutine, which is released
+ * when the awaiting coroutine suspends. This way the awaiting coroutine is resumed exactly once,
+ * even if all the coroutines finish before it gets to suspend, or if they finish in different
+ * threads.
+ */
+class CompletionCounter {
+public:
+    explicit CompletionCounter(std::size_t count) noexcept
+        : mCount(count + 1)
+    {}
+
+    CompletionCounter(const CompletionCounter &) = delete;
+    CompletionCounter &operator=(const CompletionCounter &) = delete;
+
+    //! Returns an awaitable that suspends the awaiting coroutine until all coroutines have finished.
+    auto wait() noexcept {
+        // The state is referenced through a pointer, because some compilers may copy the awaitable.
+        class Awaiter {
+        public:
+            explicit Awaiter(CompletionCounter *counter) noexcept : mCounter(counter) {}
+
+            bool await_ready() const noexcept {
+                return mCounter->mCount.load(std::memory_order_acquire) == 1;
+            }
+
+            bool await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+                mCounter->mAwaitingCoroutine = awaitingCoroutine;
+                return mCounter->mCount.fetch_sub(1, std::memory_order_acq_rel) > 1;
+            }
+
+            void await_resume() const noexcept {}
+
+        private:
+            CompletionCounter *mCounter;
+        };
+
+        return Awaiter{this};
+    }
+
+    //! Called by each coroutine when it finishes.
+    void notifyFinished() noexcept {
+        if (mCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            mAwaitingCoroutine.resume();
+        }
+    }
+
+    //! Stores the exception, unless another coroutine has already stored one.
+    void setException(std::exception_ptr exception) noexcept {
+        if (!mHasException.exchange(true, std::memory_order_relaxed)) {
+            mException = std::move(exception);
+        }
+    }
+
+    //! Rethrows the stored exception, if any. Must only be called once all coroutines have finished.
+    void rethrowException() const {
+        if (mException) {
+            std::rethrow_exception(mException);
+        }
+    }
+
+private:
+    std::atomic<std::size_t> mCount;
+    std::coroutine_handle<> mAwaitingCoroutine = {};
+    std::atomic<bool> mHasException{false};
+    std::exception_ptr mException;
+};
+
+template<typename Awaitable, typename Result>
+Task<> whenAllRunner(CompletionCounter &counter, std::optional<Result> &result, Awaitable awaitable) {
+    try {
+        if constexpr (std::is_same_v<when_result_t<Awaitable>, std::monostate>) {
+            co_await awaitable;
+            result.emplace();
+        } else {
+            result.emplace(co_await awaitable);
+        }
+    } catch (...) {
+        counter.setException(std::current_exception());
+    }
+    counter.notifyFinished();
+}
+
+template<typename Awaitable>
+Task<> whenAllRunner(CompletionCounter &counter, Awaitable awaitable) {
+    try {
+        co_await awaitable;
+    } catch (...) {
+        counter.setException(std::current_exception());
+    }
+    counter.notifyFinished();
+}
+
+} // namespace detail
+
+template<typename ... Awaitables>
+requires (detail::TaskConvertible<Awaitables> && ...)
+inline auto whenAll(Awaitables && ... awaitables) -> Task<std::tuple<detail::when_result_t<Awaitables> ...>> {
+    detail::CompletionCounter counter(sizeof...(Awaitables));
+    std::tuple<std::optional<detail::when_result_t<Awaitables>> ...> results;
+    [&]<std::size_t ... Index>(std::index_sequence<Index ...>) {
+        (detail::whenAllRunner<Awaitables>(counter, std::get<Index>(results), std::forward<Awaitables>(awaitables)), ...);
+    }(std::index_sequence_for<Awaitables ...>{});
+
+    co_await counter.wait();
+    counter.rethrowException();
+
+    co_return std::apply([](auto && ... result) {
+        return std::tuple<detail::when_result_t<Awaitables> ...>(std::move(*result) ...);
+    }, std::move(results));
+}
+
+template<typename Range>
+requires detail::TaskConvertibleRange<Range>
+inline auto whenAll(Range &&awaitables) -> Task<detail::when_all_range_result_t<Range>> {
+    using Element = detail::when_range_element_t<Range>;
+    using Result = detail::when_range_result_t<Range>;
+
+    const auto count = static_cast<std::size_t>(std::distance(std::begin(awaitables), std::end(awaitables)));
+    detail::CompletionCounter counter(count);
+    if constexpr (std::is_void_v<Result>) {
+        for (auto &&awaitable : awaitables) {
+            detail::whenAllRunner<Element>(counter, std::forward<Element>(awaitable));
+        }
+
+        co_await counter.wait();
+        counter.rethrowException();
+    } else {
+        std::vector<std::optional<Result>> results(count);
+        std::size_t index = 0;
+        for (auto &&awaitable : awaitables) {
+            detail::whenAllRunner<Element>(counter, results[index++], std::forward<Element>(awaitable));
+        }
+
+        co_await counter.wait();
+        counter.rethrowException();
+
+        std::vector<Result> values;
+        values.reserve(count);
+        for (auto &result : results) {
+            values.push_back(std::move(*result));
+        }
+        co_return values;
+    }
+}
+
+} // namespace QCoro
@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+/*
+ * Do NOT include this file directly - include the QCoroTask header instead!
+ */
+
+#pragma once
+
+#include "../qcorotask.h"
+#include "whenall.h"
+
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+
+namespace QCoro
+{
+
+namespace detail
+{
+
+//! State shared between whenAny() and the coroutines awaiting the individual awaitables.
+/*!
+ * The state is shared, because the remaining awaitables keep running after whenAny() has
+ * finished and the state must outlive them.
+ */
+template<typename Result>
+class WhenAnyState {
+public:
+    //! Returns true for the first finished coroutine, which then stores the result.
+    bool claim() noexcept {
+        return !mClaimed.exchange(true, std::memory_order_acq_rel);
+    }
+
+    CompletionCounter counter{1};
+    std::optional<Result> result;
+
+private:
+    std::atomic<bool> mClaimed{false};
+};
+
+template<std::size_t Index, typename Awaitable, typename State>
+Task<> whenAnyRunner(std::shared_ptr<State> state, Awaitable awaitable) {
+    try {
+        if constexpr (std::is_same_v<when_result_t<Awaitable>, std::monostate>) {
+            co_await awaitable;
+            if (!state->claim()) {
+                co_return;
+            }
+            state->result.emplace(std::in_place_index<Index>);
+        } else {
+            auto result = co_await awaitable;
+            if (!state->claim()) {
+                co_return;
+            }
+            state->result.emplace(std::in_place_index<Index>, std::move(result));
+        }
+    } catch (...) {
+        if (!state->claim()) {
+            co_return;
+        }
+        state->counter.setException(std::current_exception());
+    }
+    state->counter.notifyFinished();
+}
+
+template<typename Awaitable, typename State>
+Task<> whenAnyRangeRunner(std::shared_ptr<State> state, std::size_t index, Awaitable awaitable) {
+    try {
+        if constexpr (std::is_same_v<when_result_t<Awaitable>, std::monostate>) {
+            co_await awaitable;
+            if (!state->claim()) {
+                co_return;
+            }
+            state->result.emplace(index);
+        } else {
+            auto result = co_await awaitable;
+            if (!state->claim()) {
+                co_return;
+            }
+            state->result.emplace(index, std::move(result));
+        }
+    } catch (...) {
+        if (!state->claim()) {
+            co_return;
+        }
+        state->counter.setException(std::current_exception());
+    }
+    state->counter.notifyFinished();
+}
+
+} // namespace detail
+
+template<typename ... Awaitables>
+requires (sizeof...(Awaitables) > 0 && (detail::TaskConvertible<Awaitables> && ...))
+inline auto whenAny(Awaitables && ... awaitables) -> Task<std::variant<detail::when_result_t<Awaitables> ...>> {
+    using State = detail::WhenAnyState<std::variant<detail::when_result_t<Awaitables> ...>>;
+    auto state = std::make_shared<State>();
+    [&]<std::size_t ... Index>(std::index_sequence<Index ...>) {
+        (detail::whenAnyRunner<Index, Awaitables>(state, std::forward<Awaitables>(awaitables)), ...);
+    }(std::index_sequence_for<Awaitables ...>{});
+
+    co_await state->counter.wait();
+    state->counter.rethrowException();
+    co_return std::move(*state->result);
+}
+
+template<typename Range>
+requires detail::TaskConvertibleRange<Range>
+inline auto whenAny(Range &&awaitables) -> Task<detail::when_any_range_result_t<Range>> {
+    using Element = detail::when_range_element_t<Range>;
+    using State = detail::WhenAnyState<detail::when_any_range_result_t<Range>>;
+
+    if (std::begin(awaitables) == std::end(awaitables)) {
+        throw std::invalid_argument("QCoro::whenAny() called with an empty range");
+    }
+
+    auto state = std::make_shared<State>();
+    std::size_t index = 0;
+    for (auto &&awaitable : awaitables) {
+        detail::whenAnyRangeRunner<Element>(state, index++, std::forward<Element>(awaitable));
+    }
+
+    co_await state->counter.wait();
+    state->counter.rethrowException();
+    co_return std::move(*state->result);
+}
+
+} // namespace QCoro
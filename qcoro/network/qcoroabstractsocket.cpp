@@ -11,6 +11,15 @@ using namespace std::chrono_literals;
 
 namespace {
 
+bool isSocketReadChannelFinished(const QIODevice *device) {
+    return !device || static_cast<const QAbstractSocket *>(device)->state() == QAbstractSocket::UnconnectedState;
+}
+
+void registerSocketCheck() {
+    QCoro::detail::registerReadChannelFinishedCheck(&QAbstractSocket::staticMetaObject, &isSocketReadChannelFinished);
+}
+Q_CONSTRUCTOR_FUNCTION(registerSocketCheck)
+
 class AbstractSocketReadySignalHelper : public WaitSignalHelper {
     Q_OBJECT
 public:
@@ -65,6 +74,10 @@ QCoro::Task<std::optional<qint64>> QCoroAbstractSocket::waitForBytesWrittenImpl(
     co_return co_await qCoro(&helper, qOverload<qint64>(&WaitSignalHelper::ready), timeout);
 }
 
+bool QCoroAbstractSocket::isReadChannelFinished() const {
+    return isSocketReadChannelFinished(mDevice.data());
+}
+
 QCoro::Task<bool> QCoroAbstractSocket::waitForConnected(int timeout_msecs) {
     return waitForConnected(std::chrono::milliseconds{timeout_msecs});
 }
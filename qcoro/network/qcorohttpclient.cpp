@@ -0,0 +1,229 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorohttpclient.h"
+#include "qcoroevent.h"
+#include "qcoronetworkreply.h"
+#include "qcorosemaphore.h"
+#include "qcorotimer.h"
+
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QRandomGenerator>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace QCoro;
+
+namespace {
+
+//! A GET request in flight, whose response is shared by all identical GET requests.
+struct PendingGet {
+    Event finished;
+    HttpClient::Response response;
+};
+
+//! Identifies GET requests that can share a single response, their URL and headers.
+QByteArray coalescingKey(const QNetworkRequest &request) {
+    QByteArray key = request.url().toEncoded();
+    for (const auto &header : request.rawHeaderList()) {
+        key += '\n' + header + ": " + request.rawHeader(header);
+    }
+    return key;
+}
+
+//! Identifies the host whose requests in flight are limited.
+QString hostKey(const QUrl &url) {
+    return url.scheme() + QLatin1String("://") + url.host() + QLatin1Char(':')
+           + QString::number(url.port(url.scheme() == QLatin1String("https") ? 443 : 80));
+}
+
+bool isTransientFailure(const HttpClient::Response &response) {
+    switch (response.statusCode) {
+    case 408: // Request Timeout
+    case 429: // Too Many Requests
+    case 500: // Internal Server Error
+    case 502: // Bad Gateway
+    case 503: // Service Unavailable
+    case 504: // Gateway Timeout
+        return true;
+    case 0:
+        break;
+    default:
+        return false;
+    }
+
+    // No response has been received
+    switch (response.error) {
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyConnectionClosedError:
+    case QNetworkReply::ProxyTimeoutError:
+    case QNetworkReply::UnknownNetworkError:
+        return true;
+    default:
+        return false;
+    }
+}
+
+HttpClient::Response makeResponse(QNetworkReply *reply) {
+    HttpClient::Response response;
+    response.error = reply->error();
+    response.errorString = reply->errorString();
+    response.statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    response.headers = reply->rawHeaderPairs();
+    response.body = reply->readAll();
+    return response;
+}
+
+} // namespace
+
+namespace QCoro::detail {
+
+class HttpClientPrivate {
+public:
+    explicit HttpClientPrivate(QNetworkAccessManager *manager)
+        : mManager(manager)
+    {
+        if (!mManager) {
+            mOwnManager = std::make_unique<QNetworkAccessManager>();
+            mManager = mOwnManager.get();
+        }
+    }
+
+    //! Returns the semaphore limiting the requests in flight to the host of the \c url.
+    std::shared_ptr<Semaphore> hostSlots(const QUrl &url) {
+        auto &semaphore = mHostSlots[hostKey(url)];
+        if (!semaphore) {
+            semaphore = std::make_shared<Semaphore>(static_cast<std::size_t>(mMaxRequestsPerHost));
+        }
+        return semaphore;
+    }
+
+    //! Returns a random delay before the \c retry-th retry.
+    std::chrono::milliseconds retryDelay(int retry) const {
+        const double upperBound = std::min(static_cast<double>(mRetryPolicy.maxDelay.count()),
+                                           static_cast<double>(mRetryPolicy.initialDelay.count())
+                                               * std::pow(mRetryPolicy.multiplier, retry - 1));
+        return std::chrono::milliseconds{
+            QRandomGenerator::global()->bounded(static_cast<quint32>(std::max(upperBound, 0.0)) + 1)};
+    }
+
+    std::unique_ptr<QNetworkAccessManager> mOwnManager;
+    QNetworkAccessManager *mManager;
+    int mMaxRequestsPerHost = HttpClient::defaultMaxRequestsPerHost;
+    HttpClient::RetryPolicy mRetryPolicy;
+    QHash<QString, std::shared_ptr<Semaphore>> mHostSlots;
+    QHash<QByteArray, std::shared_ptr<PendingGet>> mPendingGets;
+};
+
+} // namespace QCoro::detail
+
+QByteArray HttpClient::Response::header(const QByteArray &name) const {
+    const auto it = std::find_if(headers.cbegin(), headers.cend(), [&name](const auto &header) {
+        return header.first.compare(name, Qt::CaseInsensitive) == 0;
+    });
+    return it == headers.cend() ? QByteArray{} : it->second;
+}
+
+HttpClient::HttpClient(QNetworkAccessManager *manager)
+    : d(std::make_unique<detail::HttpClientPrivate>(manager))
+{}
+
+HttpClient::~HttpClient() = default;
+
+QNetworkAccessManager *HttpClient::networkAccessManager() const {
+    return d->mManager;
+}
+
+void HttpClient::setMaxRequestsPerHost(int maxRequests) {
+    Q_ASSERT(maxRequests > 0);
+    d->mMaxRequestsPerHost = maxRequests;
+}
+
+int HttpClient::maxRequestsPerHost() const {
+    return d->mMaxRequestsPerHost;
+}
+
+void HttpClient::setRetryPolicy(const RetryPolicy &policy) {
+    d->mRetryPolicy = policy;
+}
+
+HttpClient::RetryPolicy HttpClient::retryPolicy() const {
+    return d->mRetryPolicy;
+}
+
+Task<HttpClient::Response> HttpClient::get(const QNetworkRequest &request) {
+    const auto key = coalescingKey(request);
+    if (const auto pending = d->mPendingGets.value(key)) {
+        co_await pending->finished.wait();
+        co_return pending->response;
+    }
+
+    const auto pending = std::make_shared<PendingGet>();
+    d->mPendingGets.insert(key, pending);
+    pending->response = co_await send(Operation::Get, request, {});
+    d->mPendingGets.remove(key);
+    pending->finished.set();
+    co_return pending->response;
+}
+
+Task<HttpClient::Response> HttpClient::head(const QNetworkRequest &request) {
+    return send(Operation::Head, request, {});
+}
+
+Task<HttpClient::Response> HttpClient::post(const QNetworkRequest &request, const QByteArray &data) {
+    return send(Operation::Post, request, data);
+}
+
+Task<HttpClient::Response> HttpClient::put(const QNetworkRequest &request, const QByteArray &data) {
+    return send(Operation::Put, request, data);
+}
+
+Task<HttpClient::Response> HttpClient::deleteResource(const QNetworkRequest &request) {
+    return send(Operation::Delete, request, {});
+}
+
+Task<HttpClient::Response> HttpClient::send(Operation operation, QNetworkRequest request, QByteArray data) {
+    // Retrying a POST request could perform its action twice
+    const bool retryable = operation != Operation::Post;
+    const auto hostSlots = d->hostSlots(request.url());
+    for (int attempt = 1;; ++attempt) {
+        Response response;
+        {
+            const auto permit = co_await hostSlots->scopedAcquire();
+            QNetworkReply *reply = nullptr;
+            switch (operation) {
+            case Operation::Get:
+                reply = d->mManager->get(request);
+                break;
+            case Operation::Head:
+                reply = d->mManager->head(request);
+                break;
+            case Operation::Post:
+                reply = d->mManager->post(request, data);
+                break;
+            case Operation::Put:
+                reply = d->mManager->put(request, data);
+                break;
+            case Operation::Delete:
+                reply = d->mManager->deleteResource(request);
+                break;
+            }
+            co_await reply;
+            response = makeResponse(reply);
+            reply->deleteLater();
+        }
+        response.attempts = attempt;
+
+        if (!retryable || attempt > d->mRetryPolicy.maxRetries || !isTransientFailure(response)) {
+            co_return response;
+        }
+        co_await QCoro::sleepFor(d->retryDelay(attempt));
+    }
+}
@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorotask.h"
+#include "qcoronetwork_export.h"
+
+#include <QByteArray>
+#include <QList>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QString>
+
+#include <chrono>
+#include <memory>
+
+class QNetworkAccessManager;
+
+namespace QCoro {
+
+namespace detail {
+class HttpClientPrivate;
+} // namespace detail
+
+//! Coroutine-friendly HTTP client on top of QNetworkAccessManager.
+/*!
+ * Each request produces a Response once it has finished, with the whole body read. On top of
+ * that, the client
+ *
+ * * limits the number of requests in flight to each host, further requests to the host wait
+ *   for one of them to finish before they are sent,
+ * * coalesces identical GET requests: while a GET request for a URL is in flight, further GET
+ *   requests with the same URL and headers are not sent, they produce the response of the one
+ *   in flight,
+ * * retries idempotent requests that failed with a transient error, after an exponentially
+ *   growing, randomly jittered delay, see RetryPolicy.
+ *
+ * ```cpp
+ * QCoro::HttpClient::RetryPolicy retryPolicy;
+ * retryPolicy.maxRetries = 3;
+ *
+ * QCoro::HttpClient client;
+ * client.setRetryPolicy(retryPolicy);
+ * const auto response = co_await client.get(QNetworkRequest{url});
+ * if (response.isSuccess()) {
+ *     parse(response.body);
+ * }
+ * ```
+ *
+ * The client must outlive all its pending requests.
+ */
+class QCORONETWORK_EXPORT HttpClient {
+public:
+    //! Result of a finished request.
+    struct Response {
+        //! Error of the request, QNetworkReply::NoError on success.
+        QNetworkReply::NetworkError error = QNetworkReply::NoError;
+        //! Human-readable description of the error.
+        QString errorString;
+        //! HTTP status code of the response, 0 if no response has been received.
+        int statusCode = 0;
+        //! Headers of the response.
+        QList<QNetworkReply::RawHeaderPair> headers;
+        //! Body of the response.
+        QByteArray body;
+        //! Number of times the request has been sent, more than 1 if it has been retried.
+        int attempts = 0;
+
+        //! Returns whether the request has succeeded.
+        bool isSuccess() const {
+            return error == QNetworkReply::NoError;
+        }
+
+        //! Returns the value of the response header \c name, compared case-insensitively.
+        QByteArray header(const QByteArray &name) const;
+    };
+
+    //! Controls whether and when failed requests are retried.
+    /*!
+     * Only idempotent requests (GET, HEAD, PUT and DELETE) are retried, and only when they fail
+     * with an error that may go away by itself: a connection error, a timeout, or the HTTP status
+     * 408, 429, 500, 502, 503 or 504.
+     *
+     * The n-th retry waits for a random delay between zero and
+     * `min(maxDelay, initialDelay * multiplier^(n-1))`. The randomness keeps clients that failed
+     * at the same moment from retrying at the same moment again.
+     */
+    struct RetryPolicy {
+        //! How many times a failed request is retried, 0 disables retrying.
+        int maxRetries = 0;
+        //! Upper bound of the delay before the first retry.
+        std::chrono::milliseconds initialDelay{100};
+        //! Upper bound of the delay before any retry.
+        std::chrono::milliseconds maxDelay{10'000};
+        //! Factor by which the upper bound of the delay grows with each retry.
+        double multiplier = 2.0;
+    };
+
+    //! Default limit of requests in flight to a single host.
+    static constexpr int defaultMaxRequestsPerHost = 6;
+
+    //! Creates a client sending the requests through the \c manager.
+    /*!
+     * If \c manager is \c nullptr, the client creates its own QNetworkAccessManager.
+     */
+    explicit HttpClient(QNetworkAccessManager *manager = nullptr);
+    ~HttpClient();
+    HttpClient(const HttpClient &) = delete;
+    HttpClient &operator=(const HttpClient &) = delete;
+    HttpClient(HttpClient &&) = delete;
+    HttpClient &operator=(HttpClient &&) = delete;
+
+    //! Returns the QNetworkAccessManager that sends the requests.
+    QNetworkAccessManager *networkAccessManager() const;
+
+    //! Sets the limit of requests in flight to a single host.
+    /*!
+     * The limit applies to hosts the client hasn't sent any request to yet.
+     */
+    void setMaxRequestsPerHost(int maxRequests);
+    //! Returns the limit of requests in flight to a single host.
+    int maxRequestsPerHost() const;
+
+    //! Sets the policy for retrying failed requests.
+    void setRetryPolicy(const RetryPolicy &policy);
+    //! Returns the policy for retrying failed requests.
+    RetryPolicy retryPolicy() const;
+
+    //! Sends a GET request, coalesced with identical GET requests in flight.
+    Task<Response> get(const QNetworkRequest &request);
+    //! Sends a HEAD request.
+    Task<Response> head(const QNetworkRequest &request);
+    //! Sends a POST request with the \c data, never retried.
+    Task<Response> post(const QNetworkRequest &request, const QByteArray &data);
+    //! Sends a PUT request with the \c data.
+    Task<Response> put(const QNetworkRequest &request, const QByteArray &data);
+    //! Sends a DELETE request.
+    Task<Response> deleteResource(const QNetworkRequest &request);
+
+private:
+    enum class Operation {
+        Get,
+        Head,
+        Post,
+        Put,
+        Delete,
+    };
+
+    Task<Response> send(Operation operation, QNetworkRequest request, QByteArray data);
+
+    std::unique_ptr<detail::HttpClientPrivate> d;
+};
+
+} // namespace QCoro
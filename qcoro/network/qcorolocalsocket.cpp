@@ -15,6 +15,15 @@ using namespace std::chrono_literals;
 
 namespace {
 
+bool isLocalSocketReadChannelFinished(const QIODevice *device) {
+    return !device || static_cast<const QLocalSocket *>(device)->state() == QLocalSocket::UnconnectedState;
+}
+
+void registerLocalSocketCheck() {
+    QCoro::detail::registerReadChannelFinishedCheck(&QLocalSocket::staticMetaObject, &isLocalSocketReadChannelFinished);
+}
+Q_CONSTRUCTOR_FUNCTION(registerLocalSocketCheck)
+
 class SocketConnectedHelper : public QObject {
     Q_OBJECT
 public:
@@ -93,6 +102,10 @@ QCoro::Task<std::optional<qint64>> QCoroLocalSocket::waitForBytesWrittenImpl(std
     co_return co_await qCoro(&helper, qOverload<qint64>(&LocalSocketReadySignalHelper::ready), timeout);
 }
 
+bool QCoroLocalSocket::isReadChannelFinished() const {
+    return isLocalSocketReadChannelFinished(mDevice.data());
+}
+
 QCoro::Task<bool> QCoroLocalSocket::waitForConnected(int timeout_msecs) {
     return waitForConnected(std::chrono::milliseconds(timeout_msecs));
 }
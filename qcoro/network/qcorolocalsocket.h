@@ -108,6 +108,7 @@ public:
 private:
     Task<std::optional<bool>> waitForReadyReadImpl(std::chrono::milliseconds timeout) override;
     Task<std::optional<qint64>> waitForBytesWrittenImpl(std::chrono::milliseconds timeout) override;
+    bool isReadChannelFinished() const override;
 };
 
 } // namespace QCoro::detail
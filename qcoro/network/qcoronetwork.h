@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: MIT
 
 #include "qcoroabstractsocket.h"
+#include "qcorohttpclient.h"
 #include "qcorolocalsocket.h"
 #include "qcoronetworkreply.h"
 #include "qcorotcpserver.h"
+#include "qcorothreadedtcpserver.h"
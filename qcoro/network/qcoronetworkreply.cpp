@@ -10,6 +10,15 @@ using namespace QCoro::detail;
 
 namespace {
 
+bool isReplyReadChannelFinished(const QIODevice *device) {
+    return !device || static_cast<const QNetworkReply *>(device)->isFinished();
+}
+
+void registerReplyCheck() {
+    QCoro::detail::registerReadChannelFinishedCheck(&QNetworkReply::staticMetaObject, &isReplyReadChannelFinished);
+}
+Q_CONSTRUCTOR_FUNCTION(registerReplyCheck)
+
 class ReplyWaitSignalHelper : public WaitSignalHelper {
     Q_OBJECT
 public:
@@ -80,6 +89,23 @@ QNetworkReply *QCoroNetworkReply::WaitForFinishedOperation::await_resume() const
     return d->reply;
 }
 
+QCoro::AsyncGenerator<QByteArray> QCoroNetworkReply::bodyChunks(qint64 readBufferSize, std::chrono::milliseconds timeout) {
+    Q_ASSERT(readBufferSize > 0);
+    if (auto *reply = static_cast<QNetworkReply *>(mDevice.data())) {
+        // With a full read buffer the reply stops reading from the socket until the data are consumed
+        reply->setReadBufferSize(readBufferSize);
+    }
+    return chunks(readBufferSize, timeout);
+}
+
+QCoro::Task<QCoroIODevice::TransferResult> QCoroNetworkReply::downloadTo(QIODevice *destination, qint64 bufferSize,
+                                                                        std::chrono::milliseconds timeout) {
+    const QPointer<QNetworkReply> reply = static_cast<QNetworkReply *>(mDevice.data());
+    auto result = co_await transfer(bodyChunks(bufferSize, timeout), destination, bufferSize);
+    result.complete = result.complete && reply && reply->isFinished() && reply->error() == QNetworkReply::NoError;
+    co_return result;
+}
+
 QCoro::Task<std::optional<bool>> QCoroNetworkReply::waitForReadyReadImpl(std::chrono::milliseconds timeout) {
     const auto *reply = static_cast<QNetworkReply *>(mDevice.data());
     if (reply->isFinished()) {
@@ -98,6 +124,10 @@ QCoro::Task<std::optional<qint64>> QCoroNetworkReply::waitForBytesWrittenImpl(st
     co_return co_await qCoro(&helper, qOverload<qint64>(&ReplyWaitSignalHelper::ready), timeout);
 }
 
+bool QCoroNetworkReply::isReadChannelFinished() const {
+    return isReplyReadChannelFinished(mDevice.data());
+}
+
 QCoro::Task<bool> QCoroNetworkReply::waitForFinished(std::chrono::milliseconds timeout) {
     const auto *reply = static_cast<QNetworkReply *>(mDevice.data());
     if (reply->isFinished()) {
@@ -108,4 +138,18 @@ QCoro::Task<bool> QCoroNetworkReply::waitForFinished(std::chrono::milliseconds t
     co_return result.has_value();
 }
 
+QCoro::Task<bool> QCoroNetworkReply::waitForFinished(QCoro::CancellationToken cancellationToken,
+                                                     std::chrono::milliseconds timeout) {
+    auto *reply = static_cast<QNetworkReply *>(mDevice.data());
+    if (reply->isFinished()) {
+        co_return true;
+    }
+
+    const auto result = co_await qCoro(reply, &QNetworkReply::finished, cancellationToken, timeout);
+    if (!result.has_value() && cancellationToken.isCancellationRequested() && mDevice) {
+        reply->abort();
+    }
+    co_return result.has_value();
+}
+
 #include "qcoronetworkreply.moc"
\ No newline at end of file
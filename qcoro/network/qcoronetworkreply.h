@@ -51,9 +51,60 @@ public:
      */
     Task<bool> waitForFinished(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
 
+    /**
+     * \brief Waits for the reply to finish, unless cancelled.
+     *
+     * Same as waitForFinished(std::chrono::milliseconds), but if cancellation is requested
+     * through the \c cancellationToken before the reply finishes, the reply is aborted.
+     *
+     * \return Returns `true` if the reply has finished (with or without an error), `false` if
+     * the wait has timed out or was cancelled.
+     */
+    Task<bool> waitForFinished(QCoro::CancellationToken cancellationToken,
+                               std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+    //! Default size of the reply's read buffer set by bodyChunks().
+    static constexpr qint64 defaultBodyReadBufferSize = 256 * 1024;
+
+    /**
+     * \brief Streams the body of the reply chunk by chunk.
+     *
+     * Limits the reply's [read buffer][qdoc-qnetworkreply-setReadBufferSize] to \c readBufferSize
+     * bytes and returns a generator that yields the body data as they arrive, in chunks of up to
+     * \c readBufferSize bytes. Once the read buffer is full, the reply stops receiving data from
+     * the network until the consumer requests the next chunk, so the memory used by the download
+     * stays bounded regardless of the size of the body.
+     *
+     * The generator ends once the whole body has been read and the reply has finished, when the
+     * reply is aborted or when no data arrive within the \c timeout. Check the reply's error()
+     * to tell whether the whole body has been received. If the \c timeout is -1, the generator
+     * never times out.
+     *
+     * [qdoc-qnetworkreply-setReadBufferSize]: https://doc.qt.io/qt-5/qnetworkreply.html#setReadBufferSize
+     */
+    AsyncGenerator<QByteArray> bodyChunks(qint64 readBufferSize = defaultBodyReadBufferSize,
+                                          std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
+    /**
+     * \brief Writes the body of the reply to the \c destination as it arrives.
+     *
+     * Streams the body with bodyChunks(), limiting the reply's read buffer to \c bufferSize
+     * bytes, and writes the chunks to the \c destination with flow control, so that the next
+     * chunk is only taken once fewer than \c bufferSize bytes wait in the destination's write
+     * buffer. Receiving the body from the network thus overlaps with writing it out, while at
+     * most a few buffers worth of the body are held in memory.
+     *
+     * The result is \c complete if the reply has finished without an error and the whole body
+     * has been written to the \c destination. If no data arrive within the \c timeout, the
+     * transfer stops. If the \c timeout is -1, the transfer never times out.
+     */
+    Task<TransferResult> downloadTo(QIODevice *destination, qint64 bufferSize = defaultTransferBufferSize,
+                                    std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
 private:
     Task<std::optional<bool>> waitForReadyReadImpl(std::chrono::milliseconds timeout) override;
     Task<std::optional<qint64>> waitForBytesWrittenImpl(std::chrono::milliseconds timeout) override;
+    bool isReadChannelFinished() const override;
 };
 
 } // namespace QCoro::detail
@@ -9,6 +9,49 @@
 
 using namespace QCoro::detail;
 
+namespace {
+
+//! Wakes up the connections() generator when the server has new connections or is destroyed.
+class QCoroTcpServerWakeUpNotifier : public QObject {
+    Q_OBJECT
+public:
+    QCoroTcpServerWakeUpNotifier(QTcpServer *server) {
+        connect(server, &QTcpServer::newConnection, this, &QCoroTcpServerWakeUpNotifier::wokenUp);
+        connect(server, &QObject::destroyed, this, &QCoroTcpServerWakeUpNotifier::wokenUp);
+    }
+
+Q_SIGNALS:
+    void wokenUp();
+};
+
+using WakeUpQueue = QCoroSignalQueue<QCoroTcpServerWakeUpNotifier, decltype(&QCoroTcpServerWakeUpNotifier::wokenUp)>;
+
+QCoro::AsyncGenerator<QTcpSocket *> pendingConnections(QPointer<QTcpServer> server, std::chrono::milliseconds timeout) {
+    if (!server) {
+        co_return;
+    }
+
+    // Both stay connected for the generator's whole lifetime, rather than connecting for every wait
+    QCoroTcpServerWakeUpNotifier notifier(server);
+    WakeUpQueue wakeUps(&notifier, &QCoroTcpServerWakeUpNotifier::wokenUp, timeout);
+    while (server && server->isListening()) {
+        // Accept everything that has queued up since the last wake-up before waiting again
+        while (server && server->hasPendingConnections()) {
+            co_yield server->nextPendingConnection();
+        }
+        if (!server || !server->isListening()) {
+            break;
+        }
+
+        const auto result = co_await wakeUps;
+        if (!result.has_value()) {
+            break;
+        }
+    }
+}
+
+} // namespace
+
 QCoroTcpServer::WaitForNewConnectionOperation::WaitForNewConnectionOperation(QTcpServer *server, int timeout_msecs)
     : WaitOperationBase(server, timeout_msecs) {}
 
@@ -49,3 +92,9 @@ QCoro::Task<QTcpSocket *> QCoroTcpServer::waitForNewConnection(std::chrono::mill
     }
     co_return nullptr;
 }
+
+QCoro::AsyncGenerator<QTcpSocket *> QCoroTcpServer::connections(std::chrono::milliseconds timeout) {
+    return pendingConnections(mServer, timeout);
+}
+
+#include "qcorotcpserver.moc"
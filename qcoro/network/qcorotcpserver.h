@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "qcoroasyncgenerator.h"
 #include "qcorotask.h"
 #include "waitoperationbase_p.h"
 #include "qcoronetwork_export.h"
@@ -58,6 +59,19 @@ public:
      */
     Task<QTcpSocket *> waitForNewConnection(std::chrono::milliseconds timeout);
 
+    //! Returns a generator that yields incoming connections as they arrive.
+    /*!
+     * Every time the server signals new connections, the generator yields all the pending
+     * connections, one after another, before it waits for the next signal. A burst of
+     * incoming connections is thus accepted within a single wake-up of the generator, rather
+     * than waiting for the signal for each connection separately.
+     *
+     * The generator ends when no new connection arrives within the \c timeout, or when it
+     * finds that the server has stopped listening. If the \c timeout is -1, the generator
+     * never times out.
+     */
+    AsyncGenerator<QTcpSocket *> connections(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
 private:
     QPointer<QTcpServer> mServer;
 };
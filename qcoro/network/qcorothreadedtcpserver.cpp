@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorothreadedtcpserver.h"
+
+#include "qcoroconnectionworkerpool_p.h"
+
+#include <QDebug>
+#include <QTcpSocket>
+
+using namespace QCoro;
+
+namespace {
+
+Task<> serveConnection(QObject *context, const ThreadedTcpServer::ConnectionHandler &handler,
+                       qintptr socketDescriptor) {
+    auto *socket = new QTcpSocket(context);
+    if (!socket->setSocketDescriptor(socketDescriptor)) {
+        qWarning() << "QCoro::ThreadedTcpServer: failed to set up socket for incoming connection:"
+                   << socket->errorString();
+        delete socket;
+        co_return;
+    }
+
+    co_await handler(socket);
+    socket->deleteLater();
+}
+
+} // namespace
+
+namespace QCoro::detail {
+
+class ThreadedTcpServerPrivate {
+public:
+    ThreadedTcpServerPrivate(ThreadedTcpServer::ConnectionHandler handler, int workerCount)
+        : mHandler(std::move(handler))
+        , mWorkers(QStringLiteral("QCoro::ThreadedTcpServer"), workerCount, [](QObject *socket) {
+            static_cast<QTcpSocket *>(socket)->abort();
+        })
+    {}
+
+    const ThreadedTcpServer::ConnectionHandler mHandler;
+    //! Destroyed first, waits for the handlers to finish.
+    ConnectionWorkerPool mWorkers;
+};
+
+} // namespace QCoro::detail
+
+ThreadedTcpServer::ThreadedTcpServer(ConnectionHandler handler, int workerCount, QObject *parent)
+    : QTcpServer(parent)
+    , d(std::make_unique<detail::ThreadedTcpServerPrivate>(std::move(handler), workerCount))
+{}
+
+ThreadedTcpServer::~ThreadedTcpServer() {
+    close();
+}
+
+int ThreadedTcpServer::workerCount() const {
+    return d->mWorkers.workerCount();
+}
+
+void ThreadedTcpServer::incomingConnection(qintptr socketDescriptor) {
+    d->mWorkers.dispatch([handler = &d->mHandler, socketDescriptor](QObject *context) {
+        return serveConnection(context, *handler, socketDescriptor);
+    });
+}
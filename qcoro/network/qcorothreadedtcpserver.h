@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorotask.h"
+#include "qcoronetwork_export.h"
+
+#include <QTcpServer>
+
+#include <functional>
+#include <memory>
+
+class QTcpSocket;
+
+namespace QCoro {
+
+namespace detail {
+class ThreadedTcpServerPrivate;
+} // namespace detail
+
+//! QTcpServer that serves its connections on a pool of worker threads.
+/*!
+ * The server accepts connections in the thread it lives in, but doesn't create a QTcpSocket
+ * for them there. Instead, it hands the socket descriptor of each accepted connection to one
+ * of its worker threads, in a round-robin fashion. Each worker runs its own event loop, creates
+ * the QTcpSocket for the connection and calls the connection handler coroutine for it. Reading,
+ * parsing and writing the traffic of the connections is thus spread over all the workers, while
+ * the accepting thread only accepts.
+ *
+ * ```cpp
+ * QCoro::ThreadedTcpServer server([](QTcpSocket *socket) -> QCoro::Task<> {
+ *     while (socket->state() == QAbstractSocket::ConnectedState) {
+ *         const auto request = co_await qCoro(socket).readLine();
+ *         co_await qCoro(socket).write(handleRequest(request));
+ *     }
+ * });
+ * server.listen(QHostAddress::Any, 8080);
+ * ```
+ *
+ * The handler is called from all the worker threads concurrently, so it must be thread-safe.
+ * The socket passed to the handler lives in the worker thread and is deleted once the
+ * Task returned by the handler finishes.
+ */
+class QCORONETWORK_EXPORT ThreadedTcpServer : public QTcpServer {
+    Q_OBJECT
+public:
+    //! Coroutine serving a single connection.
+    using ConnectionHandler = std::function<Task<>(QTcpSocket *)>;
+
+    //! Creates a server serving the connections with the \c handler on \c workerCount threads.
+    /*!
+     * If \c workerCount is 0, the server creates one worker per CPU core.
+     */
+    explicit ThreadedTcpServer(ConnectionHandler handler, int workerCount = 0, QObject *parent = nullptr);
+
+    //! Stops listening and stops the worker threads.
+    /*!
+     * Connections that are still open are aborted and the destructor waits for their handlers
+     * to finish, so the handlers must return once their socket is closed.
+     */
+    ~ThreadedTcpServer() override;
+
+    //! Returns the number of worker threads.
+    int workerCount() const;
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override;
+
+private:
+    std::unique_ptr<detail::ThreadedTcpServerPrivate> d;
+};
+
+} // namespace QCoro
@@ -0,0 +1,273 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace QCoro {
+
+class CancellationSource;
+class CancellationToken;
+
+template<typename Callback>
+class CancellationCallback;
+
+/*! \cond internal */
+
+namespace detail {
+
+//! Type-erased base of CancellationCallback, linked into the list of callbacks of a CancellationState.
+class CancellationCallbackBase {
+protected:
+    using InvokeFn = void (*)(CancellationCallbackBase *) noexcept;
+
+    explicit CancellationCallbackBase(InvokeFn invoke) noexcept
+        : mInvoke(invoke)
+    {}
+
+private:
+    friend class CancellationState;
+
+    InvokeFn mInvoke;
+    CancellationCallbackBase *mPrev = nullptr;
+    CancellationCallbackBase *mNext = nullptr;
+    std::atomic<bool> mFinished{false};
+};
+
+//! State shared between a CancellationSource and its CancellationTokens.
+class CancellationState {
+public:
+    bool isCancellationRequested() const noexcept {
+        return mCancelled.load(std::memory_order_acquire);
+    }
+
+    //! Marks the state as cancelled and invokes all registered callbacks in the calling thread.
+    /*!
+     * \return Returns \c true if this call has cancelled the state, \c false if it was already cancelled.
+     */
+    bool requestCancellation() noexcept {
+        std::unique_lock lock(mMutex);
+        if (mCancelled.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        mCancelled.store(true, std::memory_order_release);
+        mCancellingThread = std::this_thread::get_id();
+        while (mCallbacks != nullptr) {
+            auto *callback = mCallbacks;
+            unlink(callback);
+            mRunningCallback = callback;
+            mRunningCallbackDestroyed = false;
+            lock.unlock();
+
+            callback->mInvoke(callback);
+
+            lock.lock();
+            // The callback may have destroyed itself while it was running
+            if (!mRunningCallbackDestroyed) {
+                callback->mFinished.store(true, std::memory_order_release);
+            }
+            mRunningCallback = nullptr;
+        }
+
+        return true;
+    }
+
+    //! Registers the callback to be invoked on cancellation.
+    /*!
+     * \return Returns \c false if the state is already cancelled, in which case the callback
+     * is not registered and should be invoked by the caller.
+     */
+    bool addCallback(CancellationCallbackBase *callback) noexcept {
+        std::lock_guard lock(mMutex);
+        if (mCancelled.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        callback->mNext = mCallbacks;
+        if (mCallbacks != nullptr) {
+            mCallbacks->mPrev = callback;
+        }
+        mCallbacks = callback;
+        return true;
+    }
+
+    //! Unregisters the callback.
+    /*!
+     * If the callback is currently being invoked from another thread, waits for it to finish.
+     */
+    void removeCallback(CancellationCallbackBase *callback) noexcept {
+        std::unique_lock lock(mMutex);
+        if (callback->mPrev != nullptr || mCallbacks == callback) {
+            unlink(callback);
+            return;
+        }
+
+        if (mRunningCallback != callback) {
+            // Already invoked (or never registered)
+            return;
+        }
+
+        if (mCancellingThread == std::this_thread::get_id()) {
+            // The callback is destroying itself while being invoked
+            mRunningCallbackDestroyed = true;
+            return;
+        }
+
+        lock.unlock();
+        while (!callback->mFinished.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    void unlink(CancellationCallbackBase *callback) noexcept {
+        if (callback->mPrev != nullptr) {
+            callback->mPrev->mNext = callback->mNext;
+        } else {
+            mCallbacks = callback->mNext;
+        }
+        if (callback->mNext != nullptr) {
+            callback->mNext->mPrev = callback->mPrev;
+        }
+        callback->mPrev = nullptr;
+        callback->mNext = nullptr;
+    }
+
+    std::mutex mMutex;
+    std::atomic<bool> mCancelled{false};
+    CancellationCallbackBase *mCallbacks = nullptr;
+    CancellationCallbackBase *mRunningCallback = nullptr;
+    bool mRunningCallbackDestroyed = false;
+    std::thread::id mCancellingThread;
+};
+
+} // namespace detail
+
+/*! \endcond */
+
+//! Token observed by asynchronous operations to find out whether they should be cancelled.
+/*!
+ * A token is obtained from a CancellationSource. Cancelling the source cancels all tokens
+ * obtained from it. Tokens are cheap to copy, all copies share the same state.
+ *
+ * A default-constructed token is not associated with any source and can never be cancelled.
+ */
+class CancellationToken {
+public:
+    //! Constructs a token that can never be cancelled.
+    CancellationToken() noexcept = default;
+
+    //! Returns whether cancellation has been requested on the associated CancellationSource.
+    bool isCancellationRequested() const noexcept {
+        return mState && mState->isCancellationRequested();
+    }
+
+    //! Returns whether the token is associated with a CancellationSource and thus can be cancelled.
+    bool canBeCancelled() const noexcept {
+        return static_cast<bool>(mState);
+    }
+
+private:
+    friend class CancellationSource;
+    template<typename Callback>
+    friend class CancellationCallback;
+
+    explicit CancellationToken(std::shared_ptr<detail::CancellationState> state) noexcept
+        : mState(std::move(state))
+    {}
+
+    std::shared_ptr<detail::CancellationState> mState;
+};
+
+//! Source of CancellationTokens, used to request cancellation of asynchronous operations.
+/*!
+ * Copies of the source share the same state, so cancellation can be requested from any of them.
+ */
+class CancellationSource {
+public:
+    //! Constructs a new source.
+    CancellationSource()
+        : mState(std::make_shared<detail::CancellationState>())
+    {}
+
+    //! Returns a token associated with this source.
+    CancellationToken token() const noexcept {
+        return CancellationToken{mState};
+    }
+
+    //! Requests cancellation of all operations observing a token obtained from this source.
+    /*!
+     * All callbacks registered with the tokens are invoked synchronously from the calling thread.
+     *
+     * \return Returns \c true if this call has requested cancellation, \c false if cancellation
+     * has already been requested before.
+     */
+    bool requestCancellation() noexcept {
+        return mState->requestCancellation();
+    }
+
+    //! Returns whether cancellation has been requested.
+    bool isCancellationRequested() const noexcept {
+        return mState->isCancellationRequested();
+    }
+
+private:
+    std::shared_ptr<detail::CancellationState> mState;
+};
+
+//! Registers a callback to be invoked when cancellation is requested on the token.
+/*!
+ * The callback is invoked from the thread that requests the cancellation. If cancellation
+ * has already been requested when the CancellationCallback is constructed, the callback is
+ * invoked immediately from the constructor.
+ *
+ * Destroying the CancellationCallback unregisters the callback. If the callback is being
+ * invoked from another thread at that time, the destructor waits for it to finish.
+ */
+template<typename Callback>
+class CancellationCallback : private detail::CancellationCallbackBase {
+public:
+    template<typename C>
+    explicit CancellationCallback(const CancellationToken &token, C &&callback)
+        : detail::CancellationCallbackBase(&CancellationCallback::invoke)
+        , mCallback(std::forward<C>(callback))
+        , mState(token.mState)
+    {
+        if (mState && !mState->addCallback(this)) {
+            mState.reset();
+            mCallback();
+        }
+    }
+
+    CancellationCallback(const CancellationCallback &) = delete;
+    CancellationCallback(CancellationCallback &&) = delete;
+    CancellationCallback &operator=(const CancellationCallback &) = delete;
+    CancellationCallback &operator=(CancellationCallback &&) = delete;
+
+    ~CancellationCallback() {
+        if (mState) {
+            mState->removeCallback(this);
+        }
+    }
+
+private:
+    static void invoke(detail::CancellationCallbackBase *base) noexcept {
+        static_cast<CancellationCallback *>(base)->mCallback();
+    }
+
+    Callback mCallback;
+    std::shared_ptr<detail::CancellationState> mState;
+};
+
+template<typename Callback>
+CancellationCallback(const CancellationToken &, Callback &&) -> CancellationCallback<std::decay_t<Callback>>;
+
+} // namespace QCoro
@@ -0,0 +1,390 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcoroasyncgenerator.h"
+#include "qcoroexecutor.h"
+#include "impl/ringbuffer.h"
+#include "impl/waiterlist.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace QCoro {
+
+//! Concurrency mode of a Channel.
+enum class ChannelMode {
+    //! Only one coroutine may send and only one coroutine may receive at a time.
+    SingleProducerSingleConsumer,
+    //! Any number of coroutines may send and receive concurrently.
+    MultiProducerMultiConsumer
+};
+
+//! A bounded channel for passing values between coroutines, possibly running in different threads.
+/*!
+ * The channel buffers up to \c capacity values. Sending a value into a full channel suspends the
+ * sender until a receiver makes room, so a fast producer cannot outrun its consumers and the memory
+ * used by the channel never grows. Receiving from an empty channel suspends the receiver until
+ * a value is sent.
+ *
+ * Values are stored in a lock-free ring buffer, so sending and receiving doesn't take any lock
+ * as long as the coroutine doesn't have to be suspended or resume a suspended peer.
+ *
+ * A suspended coroutine is resumed by the executor of the thread in which it was suspended,
+ * that is from the event loop of that thread, unless a different executor is specified.
+ *
+ * ```cpp
+ * QCoro::Channel<Record> channel{64};
+ *
+ * QCoro::Task<> produce() {
+ *     while (auto record = co_await readRecord()) {
+ *         co_await channel.send(std::move(*record));
+ *     }
+ *     channel.close();
+ * }
+ *
+ * QCoro::Task<> consume() {
+ *     QCORO_FOREACH(Record &record, channel.receiveAll()) {
+ *         co_await store(record);
+ *     }
+ * }
+ * ```
+ */
+template<typename T, ChannelMode mode = ChannelMode::MultiProducerMultiConsumer>
+class Channel {
+    static_assert(std::is_move_constructible_v<T>, "Channel value type must be move-constructible");
+
+    using Buffer = std::conditional_t<mode == ChannelMode::SingleProducerSingleConsumer,
+                                      detail::SpscRingBuffer<T>, detail::MpmcRingBuffer<T>>;
+
+    /*! \cond internal */
+    struct SendWaiter : detail::Waiter {
+        T *value = nullptr;
+        bool sent = false;
+    };
+
+    struct ReceiveWaiter : detail::Waiter {
+        std::optional<T> value;
+    };
+
+    class SendOperation {
+    public:
+        SendOperation(Channel *channel, T value, Executor *executor)
+            : mChannel(channel)
+            , mValue(std::move(value))
+        {
+            mWaiter.value = &mValue;
+            mWaiter.executor = executor;
+        }
+
+        bool await_ready() {
+            mWaiter.sent = mChannel->trySendValue(mValue);
+            return mWaiter.sent || mChannel->isClosed();
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+            mWaiter.value = &mValue; // The awaiter may have been moved since it was created
+            mWaiter.prepare(awaitingCoroutine);
+            return mChannel->parkSender(&mWaiter);
+        }
+
+        //! Returns \c true if the value has been sent, \c false if the channel has been closed.
+        bool await_resume() const noexcept {
+            return mWaiter.sent;
+        }
+
+    private:
+        Channel *mChannel;
+        T mValue;
+        SendWaiter mWaiter;
+    };
+
+    class ReceiveOperation {
+    public:
+        ReceiveOperation(Channel *channel, Executor *executor) noexcept
+            : mChannel(channel)
+        {
+            mWaiter.executor = executor;
+        }
+
+        bool await_ready() {
+            mWaiter.value = mChannel->tryReceive();
+            return mWaiter.value.has_value();
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+            mWaiter.prepare(awaitingCoroutine);
+            return mChannel->parkReceiver(&mWaiter);
+        }
+
+        //! Returns the received value, or an empty optional if the channel has been closed and drained.
+        std::optional<T> await_resume() {
+            if (!mWaiter.value.has_value()) {
+                // Woken up by close(), pick up whatever has been sent before the channel was closed
+                return mChannel->tryReceive();
+            }
+            return std::move(mWaiter.value);
+        }
+
+    private:
+        Channel *mChannel;
+        ReceiveWaiter mWaiter;
+    };
+    /*! \endcond */
+
+public:
+    //! Creates a channel buffering up to \c capacity values. The \c capacity must be at least 1.
+    explicit Channel(std::size_t capacity)
+        : mBuffer(capacity)
+    {}
+
+    Channel(const Channel &) = delete;
+    Channel &operator=(const Channel &) = delete;
+
+    ~Channel() {
+        Q_ASSERT(mSenders.isEmpty());
+        Q_ASSERT(mReceivers.isEmpty());
+    }
+
+    //! Returns an awaitable that sends the \c value into the channel.
+    /*!
+     * If the channel is full, the awaiting coroutine is suspended until there's room for the value.
+     * The result of the `co_await` is \c true if the value has been sent, \c false if the channel
+     * has been closed.
+     */
+    [[nodiscard]] SendOperation send(T value) {
+        return SendOperation{this, std::move(value), nullptr};
+    }
+
+    //! \copydoc send(T)
+    /*!
+     * The awaiting coroutine is resumed by the given \c executor.
+     */
+    [[nodiscard]] SendOperation send(T value, Executor &executor) {
+        return SendOperation{this, std::move(value), &executor};
+    }
+
+    //! Sends the \c value if there's room for it in the channel.
+    /*!
+     * \return Returns \c true if the value has been sent, \c false if the channel is full or closed,
+     * in which case the \c value is left untouched.
+     */
+    [[nodiscard]] bool trySend(T &&value) {
+        return trySendValue(value);
+    }
+
+    //! \copydoc trySend(T &&)
+    [[nodiscard]] bool trySend(const T &value) {
+        T copy{value};
+        return trySendValue(copy);
+    }
+
+    //! Returns an awaitable that receives a value from the channel.
+    /*!
+     * If the channel is empty, the awaiting coroutine is suspended until a value is sent. The result
+     * of the `co_await` is the received value, or an empty optional if the channel has been closed
+     * and all values sent before have been received.
+     */
+    [[nodiscard]] ReceiveOperation receive() noexcept {
+        return ReceiveOperation{this, nullptr};
+    }
+
+    //! \copydoc receive()
+    /*!
+     * The awaiting coroutine is resumed by the given \c executor.
+     */
+    [[nodiscard]] ReceiveOperation receive(Executor &executor) noexcept {
+        return ReceiveOperation{this, &executor};
+    }
+
+    //! Receives a value if there's any in the channel.
+    std::optional<T> tryReceive() {
+        auto value = mBuffer.tryPop();
+        if (value.has_value()) {
+            notifySender();
+        }
+        return value;
+    }
+
+    //! Returns a generator producing values received from the channel until it's closed.
+    /*!
+     * In a single-consumer channel, only one generator may be consuming the channel at a time.
+     */
+    AsyncGenerator<T> receiveAll() {
+        return receiveAllImpl(nullptr);
+    }
+
+    //! \copydoc receiveAll()
+    /*!
+     * The consuming coroutine is resumed by the given \c executor whenever it has to wait for a value.
+     */
+    AsyncGenerator<T> receiveAll(Executor &executor) {
+        return receiveAllImpl(&executor);
+    }
+
+    //! Closes the channel.
+    /*!
+     * All suspended senders are resumed, their values are not sent. Further sends fail. Values already
+     * in the channel can still be received, once the channel is drained, receivers get an empty optional.
+     */
+    void close() {
+        mClosed.store(true, std::memory_order_release);
+        detail::Waiter *senders = nullptr;
+        detail::Waiter *receivers = nullptr;
+        {
+            std::lock_guard guard(mGuard);
+            senders = mSenders.takeAll();
+            receivers = mReceivers.takeAll();
+            mWaitingSenders.store(0, std::memory_order_relaxed);
+            mWaitingReceivers.store(0, std::memory_order_relaxed);
+        }
+        detail::WaiterList::resumeAll(senders);
+        detail::WaiterList::resumeAll(receivers);
+    }
+
+    //! Returns whether the channel has been closed.
+    bool isClosed() const noexcept {
+        return mClosed.load(std::memory_order_acquire);
+    }
+
+    //! Returns the maximum number of values buffered by the channel.
+    std::size_t capacity() const noexcept {
+        return mBuffer.capacity();
+    }
+
+    //! Returns the number of values currently in the channel. Only an estimate while the channel is in use.
+    std::size_t size() const noexcept {
+        return mBuffer.size();
+    }
+
+private:
+    AsyncGenerator<T> receiveAllImpl(Executor *executor) {
+        while (auto value = co_await ReceiveOperation{this, executor}) {
+            co_yield std::move(*value);
+        }
+    }
+
+    bool trySendValue(T &value) {
+        if (isClosed() || !mBuffer.tryPush(value)) {
+            return false;
+        }
+        notifyReceiver();
+        return true;
+    }
+
+    //! Hands a value from the buffer over to the first suspended receiver, if there's any.
+    void notifyReceiver() {
+        // A read-modify-write rather than a load, so that it's ordered with the increment in
+        // parkReceiver(): either we see the receiver waiting, or the receiver sees the value
+        // we've just pushed.
+        if (mWaitingReceivers.fetch_add(0, std::memory_order_acq_rel) == 0) {
+            return;
+        }
+
+        ReceiveWaiter *receiver = nullptr;
+        {
+            std::lock_guard guard(mGuard);
+            if (mReceivers.isEmpty()) {
+                return;
+            }
+            // Another receiver may have taken the value in the meantime.
+            auto value = mBuffer.tryPop();
+            if (!value.has_value()) {
+                return;
+            }
+            receiver = static_cast<ReceiveWaiter *>(mReceivers.takeFirst());
+            mWaitingReceivers.fetch_sub(1, std::memory_order_relaxed);
+            receiver->value = std::move(value);
+        }
+        receiver->resume();
+        // Taking the value has freed a slot for a suspended sender
+        notifySender();
+    }
+
+    //! Moves the value of the first suspended sender into the buffer, if there's any.
+    void notifySender() {
+        // Ordered with the increment in parkSender(), see notifyReceiver().
+        if (mWaitingSenders.fetch_add(0, std::memory_order_acq_rel) == 0) {
+            return;
+        }
+
+        SendWaiter *sender = nullptr;
+        {
+            std::lock_guard guard(mGuard);
+            if (mSenders.isEmpty()) {
+                return;
+            }
+            // Another sender may have taken the free slot in the meantime.
+            sender = static_cast<SendWaiter *>(mSenders.takeFirst());
+            if (!mBuffer.tryPush(*sender->value)) {
+                mSenders.prepend(sender);
+                return;
+            }
+            mWaitingSenders.fetch_sub(1, std::memory_order_relaxed);
+            sender->sent = true;
+        }
+        sender->resume();
+        // The sender's value may have to go to a suspended receiver
+        notifyReceiver();
+    }
+
+    //! Suspends the sender, unless its value fits into the buffer after all or the channel is closed.
+    /*!
+     * \return Returns \c true if the sender has been suspended.
+     */
+    bool parkSender(SendWaiter *sender) {
+        {
+            std::lock_guard guard(mGuard);
+            mWaitingSenders.fetch_add(1, std::memory_order_acq_rel);
+            const bool closed = isClosed();
+            sender->sent = !closed && mBuffer.tryPush(*sender->value);
+            if (!closed && !sender->sent) {
+                mSenders.append(sender);
+                return true;
+            }
+            mWaitingSenders.fetch_sub(1, std::memory_order_relaxed);
+        }
+        if (sender->sent) {
+            notifyReceiver();
+        }
+        return false;
+    }
+
+    //! Suspends the receiver, unless a value has arrived after all or the channel is closed.
+    /*!
+     * \return Returns \c true if the receiver has been suspended.
+     */
+    bool parkReceiver(ReceiveWaiter *receiver) {
+        {
+            std::lock_guard guard(mGuard);
+            mWaitingReceivers.fetch_add(1, std::memory_order_acq_rel);
+            receiver->value = mBuffer.tryPop();
+            if (!receiver->value.has_value() && !isClosed()) {
+                mReceivers.append(receiver);
+                return true;
+            }
+            mWaitingReceivers.fetch_sub(1, std::memory_order_relaxed);
+        }
+        if (receiver->value.has_value()) {
+            notifySender();
+        }
+        return false;
+    }
+
+    Buffer mBuffer;
+    std::atomic<bool> mClosed{false};
+    //! Number of suspended senders and receivers, lets the lock-free paths skip taking the lock.
+    std::atomic<std::size_t> mWaitingSenders{0};
+    std::atomic<std::size_t> mWaitingReceivers{0};
+    std::mutex mGuard;
+    detail::WaiterList mSenders;
+    detail::WaiterList mReceivers;
+};
+
+} // namespace QCoro
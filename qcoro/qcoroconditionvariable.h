@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcoromutex.h"
+#include "qcorotask.h"
+
+#include <mutex>
+#include <type_traits>
+
+namespace QCoro {
+
+//! A condition variable that suspends the awaiting coroutine instead of blocking the thread.
+/*!
+ * Used together with a QCoro::Mutex. The coroutine must hold the mutex when it starts waiting.
+ * The mutex is unlocked while the coroutine is suspended, and locked again before the coroutine
+ * is resumed.
+ *
+ * A waiting coroutine is resumed by the executor of the thread in which it started waiting,
+ * that is from the event loop of that thread, unless a different executor is specified.
+ *
+ * ```cpp
+ * QCoro::Mutex mMutex;
+ * QCoro::ConditionVariable mCondition;
+ * QQueue<Job> mJobs;
+ *
+ * QCoro::Task<Job> MyClass::takeJob() {
+ *     auto locker = co_await mMutex.scopedLock();
+ *     co_await mCondition.wait(mMutex, [this]() { return !mJobs.empty(); });
+ *     co_return mJobs.dequeue();
+ * }
+ * ```
+ */
+class ConditionVariable {
+    /*! \cond internal */
+    struct ConditionWaiter : detail::Waiter {
+        Mutex *mutex = nullptr;
+    };
+
+    class WaitOperation {
+    public:
+        WaitOperation(ConditionVariable *condition, Mutex *mutex, Executor *executor) noexcept
+            : mCondition(condition)
+        {
+            mWaiter.mutex = mutex;
+            mWaiter.executor = executor;
+        }
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+            mWaiter.prepare(awaitingCoroutine);
+            // Enqueued before the mutex is unlocked, so that a notification sent by whoever
+            // locks the mutex next cannot be missed.
+            auto *mutex = mWaiter.mutex;
+            mCondition->enqueue(&mWaiter);
+            // The waiter may be resumed as soon as the mutex is unlocked, so it must not be accessed afterwards.
+            mutex->unlock();
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        ConditionVariable *mCondition;
+        ConditionWaiter mWaiter;
+    };
+    /*! \endcond */
+
+public:
+    ConditionVariable() = default;
+    ConditionVariable(const ConditionVariable &) = delete;
+    ConditionVariable &operator=(const ConditionVariable &) = delete;
+
+    ~ConditionVariable() {
+        Q_ASSERT(mWaiters.isEmpty());
+    }
+
+    //! Returns an awaitable that unlocks the \c mutex and suspends the awaiting coroutine until notified.
+    /*!
+     * The \c mutex must be locked by the awaiting coroutine. It is locked again when the coroutine
+     * is resumed.
+     */
+    [[nodiscard]] WaitOperation wait(Mutex &mutex) noexcept {
+        return WaitOperation{this, &mutex, nullptr};
+    }
+
+    //! \copydoc wait(Mutex &)
+    /*!
+     * The awaiting coroutine is resumed by the given \c executor.
+     */
+    [[nodiscard]] WaitOperation wait(Mutex &mutex, Executor &executor) noexcept {
+        return WaitOperation{this, &mutex, &executor};
+    }
+
+    //! Waits until the \c predicate returns \c true.
+    /*!
+     * Equivalent to
+     * ```cpp
+     * while (!predicate()) {
+     *     co_await wait(mutex);
+     * }
+     * ```
+     */
+    template<typename Predicate>
+    requires std::is_invocable_r_v<bool, Predicate &>
+    Task<> wait(Mutex &mutex, Predicate predicate) {
+        while (!predicate()) {
+            co_await wait(mutex);
+        }
+    }
+
+    //! Resumes the first waiting coroutine, once it gets the mutex.
+    void notifyOne() noexcept {
+        detail::Waiter *waiter = nullptr;
+        {
+            std::lock_guard guard(mGuard);
+            waiter = mWaiters.takeFirst();
+        }
+        if (waiter != nullptr) {
+            relock(static_cast<ConditionWaiter *>(waiter));
+        }
+    }
+
+    //! Resumes all waiting coroutines, each once it gets the mutex.
+    void notifyAll() noexcept {
+        detail::Waiter *waiter = nullptr;
+        {
+            std::lock_guard guard(mGuard);
+            waiter = mWaiters.takeAll();
+        }
+        while (waiter != nullptr) {
+            auto *next = waiter->next;
+            relock(static_cast<ConditionWaiter *>(waiter));
+            waiter = next;
+        }
+    }
+
+private:
+    void enqueue(ConditionWaiter *waiter) noexcept {
+        std::lock_guard guard(mGuard);
+        mWaiters.append(waiter);
+    }
+
+    //! Moves the notified waiter into the mutex's queue, or resumes it right away if the mutex is unlocked.
+    static void relock(ConditionWaiter *waiter) noexcept {
+        if (!waiter->mutex->enqueue(waiter)) {
+            waiter->resume();
+        }
+    }
+
+    std::mutex mGuard;
+    detail::WaiterList mWaiters;
+};
+
+} // namespace QCoro
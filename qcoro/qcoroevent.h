@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcoroexecutor.h"
+#include "impl/waiterlist.h"
+
+#include <mutex>
+
+namespace QCoro {
+
+//! An event that coroutines can wait for without blocking the thread.
+/*!
+ * A manual-reset event, once set, lets all waiting coroutines and all coroutines that wait
+ * for it later continue, until it's reset again.
+ *
+ * An automatic-reset event lets only a single coroutine continue each time it's set and then
+ * resets itself automatically. If no coroutine is waiting when the event is set, the event
+ * stays set until the next coroutine waits for it.
+ *
+ * A waiting coroutine is resumed by the executor of the thread in which it started waiting,
+ * that is from the event loop of that thread, unless a different executor is specified.
+ */
+class Event {
+    /*! \cond internal */
+    class WaitOperation {
+    public:
+        WaitOperation(Event *event, Executor *executor) noexcept
+            : mEvent(event)
+        {
+            mWaiter.executor = executor;
+        }
+
+        bool await_ready() noexcept {
+            return mEvent->tryConsume();
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+            mWaiter.prepare(awaitingCoroutine);
+            return mEvent->enqueue(&mWaiter);
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        Event *mEvent;
+        detail::Waiter mWaiter;
+    };
+    /*! \endcond */
+
+public:
+    enum class ResetMode {
+        Manual,   //!< The event stays set until reset() is called.
+        Automatic //!< The event is reset automatically when a single waiting coroutine is let through.
+    };
+
+    //! Creates an event, which is not set unless \c initiallySet is \c true.
+    explicit Event(ResetMode mode = ResetMode::Manual, bool initiallySet = false) noexcept
+        : mMode(mode)
+        , mSet(initiallySet)
+    {}
+
+    Event(const Event &) = delete;
+    Event &operator=(const Event &) = delete;
+
+    ~Event() {
+        Q_ASSERT(mWaiters.isEmpty());
+    }
+
+    //! Returns an awaitable that suspends the awaiting coroutine until the event is set.
+    [[nodiscard]] WaitOperation wait() noexcept {
+        return WaitOperation{this, nullptr};
+    }
+
+    //! \copydoc wait()
+    /*!
+     * The awaiting coroutine is resumed by the given \c executor.
+     */
+    [[nodiscard]] WaitOperation wait(Executor &executor) noexcept {
+        return WaitOperation{this, &executor};
+    }
+
+    //! Sets the event.
+    /*!
+     * A manual-reset event resumes all waiting coroutines. An automatic-reset event resumes
+     * the first waiting coroutine, or stays set if there's none.
+     */
+    void set() noexcept {
+        detail::Waiter *resumed = nullptr;
+        {
+            std::lock_guard guard(mGuard);
+            if (mMode == ResetMode::Manual) {
+                mSet = true;
+                resumed = mWaiters.takeAll();
+            } else {
+                resumed = mWaiters.takeFirst();
+                if (resumed == nullptr) {
+                    mSet = true;
+                } else {
+                    resumed->next = nullptr;
+                }
+            }
+        }
+        detail::WaiterList::resumeAll(resumed);
+    }
+
+    //! Resets the event, so that coroutines waiting for it get suspended.
+    void reset() noexcept {
+        std::lock_guard guard(mGuard);
+        mSet = false;
+    }
+
+    //! Returns whether the event is set.
+    bool isSet() const noexcept {
+        std::lock_guard guard(mGuard);
+        return mSet;
+    }
+
+    //! Returns the reset mode of the event.
+    ResetMode resetMode() const noexcept {
+        return mMode;
+    }
+
+private:
+    //! Returns whether a waiter can continue right away, resetting an automatic-reset event.
+    bool tryConsume() noexcept {
+        std::lock_guard guard(mGuard);
+        return consume();
+    }
+
+    //! Enqueues the waiter, unless the event is set.
+    /*!
+     * \return Returns \c true if the waiter has been enqueued, \c false if it can continue.
+     */
+    bool enqueue(detail::Waiter *waiter) noexcept {
+        std::lock_guard guard(mGuard);
+        if (consume()) {
+            return false;
+        }
+        mWaiters.append(waiter);
+        return true;
+    }
+
+    bool consume() noexcept {
+        if (!mSet) {
+            return false;
+        }
+        if (mMode == ResetMode::Automatic) {
+            mSet = false;
+        }
+        return true;
+    }
+
+    mutable std::mutex mGuard;
+    const ResetMode mMode;
+    bool mSet;
+    detail::WaiterList mWaiters;
+};
+
+} // namespace QCoro
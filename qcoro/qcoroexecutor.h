@@ -0,0 +1,264 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "coroutine.h"
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QHash>
+#include <QObject>
+#include <QThread>
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+namespace QCoro {
+
+class Executor;
+
+/*! \cond internal */
+
+namespace detail {
+
+//! A coroutine scheduled to be resumed by an Executor.
+/*!
+ * The node is embedded in the awaiter that schedules the coroutine, so scheduling
+ * a coroutine never allocates. The node must stay alive and must not be scheduled
+ * again until the coroutine has been resumed.
+ */
+struct ScheduledCoroutine {
+    std::coroutine_handle<> coroutine = {};
+    ScheduledCoroutine *next = nullptr;
+};
+
+//! Lock-free queue of coroutines to be resumed from the event loop of a thread.
+/*!
+ * Any thread can push to the queue. Only the first push into an empty queue posts an
+ * event to the queue's thread, the event then resumes all coroutines queued so far in
+ * the order in which they were pushed. Coroutines pushed while the queue is being
+ * drained are resumed in the next event loop iteration.
+ */
+class RunQueue final : public QObject {
+public:
+    explicit RunQueue(QThread *thread) {
+        moveToThread(thread);
+    }
+
+    void push(ScheduledCoroutine &node) noexcept {
+        auto *head = mHead.load(std::memory_order_relaxed);
+        do {
+            node.next = head;
+        } while (!mHead.compare_exchange_weak(head, &node, std::memory_order_release, std::memory_order_relaxed));
+
+        if (head == nullptr) {
+            QCoreApplication::postEvent(this, new QEvent(eventType()));
+        }
+    }
+
+    //! Whether the queue is currently resuming coroutines, in which case it must not be deleted directly.
+    bool isDraining() const noexcept {
+        return mDrainDepth > 0;
+    }
+
+protected:
+    bool event(QEvent *event) override {
+        if (event->type() != eventType()) {
+            return QObject::event(event);
+        }
+
+        // The nodes are pushed to the front of the list, reverse them to resume them in FIFO order.
+        auto *node = mHead.exchange(nullptr, std::memory_order_acquire);
+        ScheduledCoroutine *first = nullptr;
+        while (node != nullptr) {
+            auto *next = node->next;
+            node->next = first;
+            first = node;
+            node = next;
+        }
+
+        ++mDrainDepth;
+        while (first != nullptr) {
+            // The node is destroyed when the resumed coroutine continues past its awaiter.
+            auto *next = first->next;
+            first->coroutine.resume();
+            first = next;
+        }
+        --mDrainDepth;
+
+        return true;
+    }
+
+private:
+    static QEvent::Type eventType() {
+        static const auto type = static_cast<QEvent::Type>(QEvent::registerEventType());
+        return type;
+    }
+
+    std::atomic<ScheduledCoroutine *> mHead{nullptr};
+    int mDrainDepth = 0;
+};
+
+//! Awaitable returned by Executor::schedule().
+class ScheduleOperation {
+public:
+    explicit ScheduleOperation(Executor *executor) noexcept
+        : mExecutor(executor)
+    {}
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept;
+
+    void await_resume() const noexcept {}
+
+private:
+    Executor *mExecutor;
+    ScheduledCoroutine mNode;
+};
+
+} // namespace detail
+
+/*! \endcond */
+
+//! Decides where and when suspended coroutines are resumed.
+/*!
+ * Awaitables that need to resume the awaiting coroutine later, rather than from the code that
+ * completed the operation, post the coroutine to an executor. Coroutines can also move themselves
+ * to an executor explicitly by `co_await`ing schedule().
+ */
+class Executor {
+public:
+    virtual ~Executor() = default;
+
+    //! Schedules the coroutine stored in the \c node to be resumed by this executor.
+    /*!
+     * The \c node must stay alive and must not be posted again until the coroutine is resumed.
+     * Can be called from any thread.
+     */
+    virtual void post(detail::ScheduledCoroutine &node) noexcept = 0;
+
+    //! Returns an awaitable that suspends the awaiting coroutine and resumes it on this executor.
+    detail::ScheduleOperation schedule() noexcept {
+        return detail::ScheduleOperation{this};
+    }
+
+protected:
+    Executor() = default;
+    Executor(const Executor &) = delete;
+    Executor &operator=(const Executor &) = delete;
+};
+
+//! Executor that resumes the coroutine immediately in the thread that posts it.
+class InlineExecutor final : public Executor {
+public:
+    void post(detail::ScheduledCoroutine &node) noexcept override {
+        node.coroutine.resume();
+    }
+
+    //! Returns a shared instance of the executor.
+    static InlineExecutor &instance() noexcept {
+        static InlineExecutor executor;
+        return executor;
+    }
+};
+
+//! Executor that resumes coroutines from the event loop of a specific thread.
+/*!
+ * Posting a coroutine is a single lock-free push into the thread's run queue. The queue is drained
+ * once per event loop iteration, so resuming many coroutines costs a single posted event rather than
+ * a timer or a queued slot invocation for each of them.
+ *
+ * The thread must be running an event loop for the coroutines to be resumed.
+ */
+class ThreadExecutor final : public Executor {
+public:
+    //! Creates an executor resuming coroutines in the given thread.
+    /*!
+     * Prefer the shared executor returned by forThread(), unless the executor's lifetime needs
+     * to be controlled explicitly.
+     */
+    explicit ThreadExecutor(QThread *thread)
+        : mQueue(new detail::RunQueue(thread))
+    {}
+
+    ~ThreadExecutor() override {
+        if (mQueue == nullptr) {
+            return;
+        }
+        if (mQueue->thread() == QThread::currentThread() && !mQueue->isDraining()) {
+            delete mQueue;
+        } else {
+            mQueue->deleteLater();
+        }
+    }
+
+    //! Returns the shared executor for the current thread.
+    /*!
+     * This is the executor used by QCoro's awaitables to resume the awaiting coroutine from the
+     * event loop. Same as `forThread(QThread::currentThread())`, but without the lookup.
+     */
+    static ThreadExecutor &current() {
+        static thread_local ThreadExecutor *executor = &forThread(QThread::currentThread());
+        return *executor;
+    }
+
+    //! Returns the shared executor for the given thread.
+    /*!
+     * The executor is created on first use and exists until the \c thread object is destroyed.
+     * It's safe to call from any thread. The executor can be used even before the thread is
+     * started, the coroutines are resumed once the thread starts its event loop.
+     */
+    static ThreadExecutor &forThread(QThread *thread) {
+        auto &registry = sharedExecutors();
+        std::lock_guard lock(registry.mutex);
+        auto &executor = registry.executors[thread];
+        if (executor == nullptr) {
+            executor = new ThreadExecutor(thread);
+            // The thread has finished by the time it's destroyed, so the queue can be deleted right away.
+            QObject::connect(thread, &QObject::destroyed, [thread]() {
+                auto &registry = sharedExecutors();
+                std::lock_guard lock(registry.mutex);
+                auto *executor = registry.executors.take(thread);
+                delete std::exchange(executor->mQueue, nullptr);
+                delete executor;
+            });
+        }
+        return *executor;
+    }
+
+    //! Returns the thread in which this executor resumes coroutines.
+    QThread *thread() const {
+        return mQueue->thread();
+    }
+
+    void post(detail::ScheduledCoroutine &node) noexcept override {
+        mQueue->push(node);
+    }
+
+private:
+    struct SharedExecutors {
+        std::mutex mutex;
+        QHash<QThread *, ThreadExecutor *> executors;
+    };
+
+    static SharedExecutors &sharedExecutors() {
+        // Intentionally leaked: adopted threads are destroyed during static destruction.
+        static auto *registry = new SharedExecutors;
+        return *registry;
+    }
+
+    detail::RunQueue *mQueue;
+};
+
+inline void detail::ScheduleOperation::await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+    mNode.coroutine = awaitingCoroutine;
+    mExecutor->post(mNode);
+}
+
+} // namespace QCoro
@@ -11,5 +11,12 @@ template<typename T> class Generator;
 template<typename T> class GeneratorIterator;
 template<typename T> class AsyncGenerator;
 template<typename T> class AsyncGeneratorIterator;
+class CancellationSource;
+class CancellationToken;
+class Executor;
+class Mutex;
+class Semaphore;
+class Event;
+class ConditionVariable;
 
 } // namespace QCoro
@@ -45,7 +45,12 @@ public:
 
     using detail::TaskBase<T, LazyTask, promise_type>::TaskBase;
 
-    ~LazyTask() override;
+    //! The task can be move-constructed.
+    LazyTask(LazyTask &&other) noexcept = default;
+    //! The task can be move-assigned.
+    LazyTask &operator=(LazyTask &&other) noexcept = default;
+
+    ~LazyTask();
 
     auto operator co_await() const noexcept;
 };
@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcoroexecutor.h"
+#include "impl/waiterlist.h"
+
+#include <mutex>
+#include <utility>
+
+namespace QCoro {
+
+class ConditionVariable;
+class Mutex;
+
+//! Unlocks a Mutex when destroyed, returned by Mutex::scopedLock().
+class MutexLocker {
+public:
+    //! Takes over an already locked \c mutex.
+    explicit MutexLocker(Mutex &mutex, std::adopt_lock_t) noexcept
+        : mMutex(&mutex)
+    {}
+
+    MutexLocker(const MutexLocker &) = delete;
+    MutexLocker &operator=(const MutexLocker &) = delete;
+
+    MutexLocker(MutexLocker &&other) noexcept
+        : mMutex(std::exchange(other.mMutex, nullptr))
+    {}
+
+    MutexLocker &operator=(MutexLocker &&other) noexcept {
+        if (this != &other) {
+            unlock();
+            mMutex = std::exchange(other.mMutex, nullptr);
+        }
+        return *this;
+    }
+
+    ~MutexLocker() {
+        unlock();
+    }
+
+    //! Unlocks the mutex before the locker is destroyed.
+    void unlock() noexcept;
+
+    //! Returns the locked mutex, or \c nullptr if it has already been unlocked.
+    Mutex *mutex() const noexcept {
+        return mMutex;
+    }
+
+private:
+    Mutex *mMutex;
+};
+
+//! A mutex that suspends the awaiting coroutine instead of blocking the thread.
+/*!
+ * The mutex is not recursive and it's not bound to a thread: it can be locked from one thread
+ * and unlocked from another. The lock is handed over to waiting coroutines in the order in
+ * which they started waiting.
+ *
+ * A waiting coroutine is resumed by the executor of the thread in which it started waiting,
+ * that is from the event loop of that thread, unless a different executor is specified.
+ *
+ * ```cpp
+ * QCoro::Mutex mutex;
+ *
+ * QCoro::Task<> MyClass::update() {
+ *     const auto locker = co_await mMutex.scopedLock();
+ *     ...
+ * }
+ * ```
+ */
+class Mutex {
+    /*! \cond internal */
+    class LockOperation {
+    public:
+        LockOperation(Mutex *mutex, Executor *executor) noexcept
+            : mMutex(mutex)
+        {
+            mWaiter.executor = executor;
+        }
+
+        bool await_ready() noexcept {
+            return mMutex->tryLock();
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+            mWaiter.prepare(awaitingCoroutine);
+            return mMutex->enqueue(&mWaiter);
+        }
+
+        void await_resume() const noexcept {}
+
+    protected:
+        Mutex *mMutex;
+        detail::Waiter mWaiter;
+    };
+
+    class ScopedLockOperation : public LockOperation {
+    public:
+        using LockOperation::LockOperation;
+
+        [[nodiscard]] MutexLocker await_resume() const noexcept {
+            return MutexLocker{*mMutex, std::adopt_lock};
+        }
+    };
+    /*! \endcond */
+
+public:
+    Mutex() = default;
+    Mutex(const Mutex &) = delete;
+    Mutex &operator=(const Mutex &) = delete;
+
+    ~Mutex() {
+        Q_ASSERT(mWaiters.isEmpty());
+    }
+
+    //! Locks the mutex if it's not locked yet.
+    /*!
+     * \return Returns \c true if the mutex has been locked, \c false if it's locked already.
+     */
+    [[nodiscard]] bool tryLock() noexcept {
+        std::lock_guard guard(mGuard);
+        if (mLocked) {
+            return false;
+        }
+        mLocked = true;
+        return true;
+    }
+
+    //! Returns an awaitable that locks the mutex.
+    /*!
+     * If the mutex is locked, the awaiting coroutine is suspended until it gets the lock.
+     * The mutex must be unlocked by calling unlock().
+     */
+    [[nodiscard]] LockOperation lock() noexcept {
+        return LockOperation{this, nullptr};
+    }
+
+    //! \copydoc lock()
+    /*!
+     * The awaiting coroutine is resumed by the given \c executor.
+     */
+    [[nodiscard]] LockOperation lock(Executor &executor) noexcept {
+        return LockOperation{this, &executor};
+    }
+
+    //! Returns an awaitable that locks the mutex and produces a MutexLocker that unlocks it when destroyed.
+    [[nodiscard]] ScopedLockOperation scopedLock() noexcept {
+        return ScopedLockOperation{this, nullptr};
+    }
+
+    //! \copydoc scopedLock()
+    /*!
+     * The awaiting coroutine is resumed by the given \c executor.
+     */
+    [[nodiscard]] ScopedLockOperation scopedLock(Executor &executor) noexcept {
+        return ScopedLockOperation{this, &executor};
+    }
+
+    //! Unlocks the mutex, handing it over to the first waiting coroutine, if any.
+    void unlock() noexcept {
+        detail::Waiter *next = nullptr;
+        {
+            std::lock_guard guard(mGuard);
+            Q_ASSERT(mLocked);
+            next = mWaiters.takeFirst();
+            if (next == nullptr) {
+                mLocked = false;
+            }
+        }
+        if (next != nullptr) {
+            next->resume();
+        }
+    }
+
+    //! Returns whether the mutex is currently locked.
+    bool isLocked() const noexcept {
+        std::lock_guard guard(mGuard);
+        return mLocked;
+    }
+
+private:
+    friend class ConditionVariable;
+
+    //! Locks the mutex for the waiter, or enqueues the waiter if the mutex is locked.
+    /*!
+     * \return Returns \c true if the waiter has been enqueued, \c false if it got the lock.
+     */
+    bool enqueue(detail::Waiter *waiter) noexcept {
+        std::lock_guard guard(mGuard);
+        if (!mLocked) {
+            mLocked = true;
+            return false;
+        }
+        mWaiters.append(waiter);
+        return true;
+    }
+
+    mutable std::mutex mGuard;
+    bool mLocked = false;
+    detail::WaiterList mWaiters;
+};
+
+inline void MutexLocker::unlock() noexcept {
+    if (auto *mutex = std::exchange(mMutex, nullptr); mutex != nullptr) {
+        mutex->unlock();
+    }
+}
+
+} // namespace QCoro
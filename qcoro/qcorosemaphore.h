@@ -0,0 +1,215 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcoroexecutor.h"
+#include "impl/waiterlist.h"
+
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+namespace QCoro {
+
+class Semaphore;
+
+//! Releases a permit back to a Semaphore when destroyed, returned by Semaphore::scopedAcquire().
+class SemaphoreReleaser {
+public:
+    //! Takes over a permit already acquired from the \c semaphore.
+    explicit SemaphoreReleaser(Semaphore &semaphore) noexcept
+        : mSemaphore(&semaphore)
+    {}
+
+    SemaphoreReleaser(const SemaphoreReleaser &) = delete;
+    SemaphoreReleaser &operator=(const SemaphoreReleaser &) = delete;
+
+    SemaphoreReleaser(SemaphoreReleaser &&other) noexcept
+        : mSemaphore(std::exchange(other.mSemaphore, nullptr))
+    {}
+
+    SemaphoreReleaser &operator=(SemaphoreReleaser &&other) noexcept {
+        if (this != &other) {
+            release();
+            mSemaphore = std::exchange(other.mSemaphore, nullptr);
+        }
+        return *this;
+    }
+
+    ~SemaphoreReleaser() {
+        release();
+    }
+
+    //! Releases the permit before the releaser is destroyed.
+    void release() noexcept;
+
+    //! Returns the semaphore, or \c nullptr if the permit has already been released.
+    Semaphore *semaphore() const noexcept {
+        return mSemaphore;
+    }
+
+private:
+    Semaphore *mSemaphore;
+};
+
+//! A counting semaphore that suspends the awaiting coroutine instead of blocking the thread.
+/*!
+ * The semaphore holds a number of permits. Acquiring a permit when none are available suspends
+ * the coroutine until another coroutine releases one. Released permits are handed over to waiting
+ * coroutines in the order in which they started waiting.
+ *
+ * A waiting coroutine is resumed by the executor of the thread in which it started waiting,
+ * that is from the event loop of that thread, unless a different executor is specified.
+ *
+ * A typical use is limiting the number of concurrently running operations:
+ *
+ * ```cpp
+ * QCoro::Semaphore mRequestSlots{4};
+ *
+ * QCoro::Task<QByteArray> MyClass::fetch(QUrl url) {
+ *     const auto permit = co_await mRequestSlots.scopedAcquire();
+ *     auto *reply = co_await mNam.get(QNetworkRequest{url});
+ *     ...
+ * }
+ * ```
+ */
+class Semaphore {
+    /*! \cond internal */
+    class AcquireOperation {
+    public:
+        AcquireOperation(Semaphore *semaphore, Executor *executor) noexcept
+            : mSemaphore(semaphore)
+        {
+            mWaiter.executor = executor;
+        }
+
+        bool await_ready() noexcept {
+            return mSemaphore->tryAcquire();
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+            mWaiter.prepare(awaitingCoroutine);
+            return mSemaphore->enqueue(&mWaiter);
+        }
+
+        void await_resume() const noexcept {}
+
+    protected:
+        Semaphore *mSemaphore;
+        detail::Waiter mWaiter;
+    };
+
+    class ScopedAcquireOperation : public AcquireOperation {
+    public:
+        using AcquireOperation::AcquireOperation;
+
+        [[nodiscard]] SemaphoreReleaser await_resume() const noexcept {
+            return SemaphoreReleaser{*mSemaphore};
+        }
+    };
+    /*! \endcond */
+
+public:
+    //! Creates a semaphore with the given number of available permits.
+    explicit Semaphore(std::size_t permits) noexcept
+        : mAvailable(permits)
+    {}
+
+    Semaphore(const Semaphore &) = delete;
+    Semaphore &operator=(const Semaphore &) = delete;
+
+    ~Semaphore() {
+        Q_ASSERT(mWaiters.isEmpty());
+    }
+
+    //! Acquires a permit if one is available.
+    /*!
+     * \return Returns \c true if a permit has been acquired, \c false otherwise.
+     */
+    [[nodiscard]] bool tryAcquire() noexcept {
+        std::lock_guard guard(mGuard);
+        if (mAvailable == 0) {
+            return false;
+        }
+        --mAvailable;
+        return true;
+    }
+
+    //! Returns an awaitable that acquires a permit.
+    /*!
+     * If no permit is available, the awaiting coroutine is suspended until it gets one.
+     * The permit must be returned by calling release().
+     */
+    [[nodiscard]] AcquireOperation acquire() noexcept {
+        return AcquireOperation{this, nullptr};
+    }
+
+    //! \copydoc acquire()
+    /*!
+     * The awaiting coroutine is resumed by the given \c executor.
+     */
+    [[nodiscard]] AcquireOperation acquire(Executor &executor) noexcept {
+        return AcquireOperation{this, &executor};
+    }
+
+    //! Returns an awaitable that acquires a permit and produces a SemaphoreReleaser that returns it when destroyed.
+    [[nodiscard]] ScopedAcquireOperation scopedAcquire() noexcept {
+        return ScopedAcquireOperation{this, nullptr};
+    }
+
+    //! \copydoc scopedAcquire()
+    /*!
+     * The awaiting coroutine is resumed by the given \c executor.
+     */
+    [[nodiscard]] ScopedAcquireOperation scopedAcquire(Executor &executor) noexcept {
+        return ScopedAcquireOperation{this, &executor};
+    }
+
+    //! Releases \c permits permits, handing them over to waiting coroutines first.
+    void release(std::size_t permits = 1) noexcept {
+        detail::WaiterList resumed;
+        {
+            std::lock_guard guard(mGuard);
+            for (; permits > 0 && !mWaiters.isEmpty(); --permits) {
+                resumed.append(mWaiters.takeFirst());
+            }
+            mAvailable += permits;
+        }
+        detail::WaiterList::resumeAll(resumed.takeAll());
+    }
+
+    //! Returns the number of currently available permits.
+    std::size_t available() const noexcept {
+        std::lock_guard guard(mGuard);
+        return mAvailable;
+    }
+
+private:
+    //! Acquires a permit for the waiter, or enqueues the waiter if none is available.
+    /*!
+     * \return Returns \c true if the waiter has been enqueued, \c false if it got a permit.
+     */
+    bool enqueue(detail::Waiter *waiter) noexcept {
+        std::lock_guard guard(mGuard);
+        if (mAvailable > 0) {
+            --mAvailable;
+            return false;
+        }
+        mWaiters.append(waiter);
+        return true;
+    }
+
+    mutable std::mutex mGuard;
+    std::size_t mAvailable;
+    detail::WaiterList mWaiters;
+};
+
+inline void SemaphoreReleaser::release() noexcept {
+    if (auto *semaphore = std::exchange(mSemaphore, nullptr); semaphore != nullptr) {
+        semaphore->release();
+    }
+}
+
+} // namespace QCoro
@@ -8,10 +8,14 @@
 #include "concepts_p.h"
 
 #include <atomic>
+#include <cstddef>
 #include <exception>
+#include <iterator>
 #include <variant>
 #include <memory>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace QCoro {
@@ -19,6 +23,30 @@ namespace QCoro {
 template<typename T = void>
 class Task;
 
+//! Statistics of the per-thread pool of coroutine frames.
+/*!
+ * Frames of Task and LazyTask coroutines that were not given a custom allocator
+ * are recycled through a small per-thread pool. The statistics are collected
+ * per thread, see framePoolStatistics().
+ */
+struct FramePoolStatistics {
+    //! Number of coroutine frames allocated from the pool.
+    std::size_t allocations = 0;
+    //! Number of allocations that reused a previously released frame.
+    std::size_t poolHits = 0;
+    //! Number of coroutine frames released back to the pool.
+    std::size_t deallocations = 0;
+
+    //! Returns the ratio of allocations served by reusing a released frame.
+    double hitRate() const noexcept;
+};
+
+//! Returns frame pool statistics for the current thread.
+FramePoolStatistics framePoolStatistics() noexcept;
+
+//! Resets frame pool statistics for the current thread.
+void resetFramePoolStatistics() noexcept;
+
 /*! \cond internal */
 
 namespace detail {
@@ -32,12 +60,12 @@ using awaiter_type_t = typename awaiter_type<T>::type;
 //! Continuation that resumes a coroutine co_awaiting on currently finished coroutine.
 class TaskFinalSuspend {
 public:
-    //! Constructs the awaitable, passing it a handle to the co_awaiting coroutine
+    //! Constructs the awaitable.
     /*!
-     * \param[in] awaitingCoroutine handle of the coroutine that is co_awaiting the current
-     * coroutine (continuation).
+     * The coroutines co_awaiting the finished coroutine are obtained from its promise
+     * in await_suspend(), so that they don't have to be copied.
      */
-    explicit TaskFinalSuspend(const std::vector<std::coroutine_handle<>> &awaitingCoroutines);
+    explicit TaskFinalSuspend() noexcept = default;
 
     //! Returns whether the just finishing coroutine should do final suspend or not
     /*!
@@ -51,15 +79,21 @@ public:
     //! Called by the compiler when the just-finished coroutine is suspended. for the very last time.
     /*!
      * It is given handle of the coroutine that is being co_awaited (that is the current
-     * coroutine). If there is a co_awaiting coroutine and it has not been resumed yet,
-     * it resumes it.
+     * coroutine). If there are co_awaiting coroutines, all but the last one are resumed
+     * directly, and handle of the last one is returned so that the compiler can transfer
+     * execution to it without growing the stack (symmetric transfer). This is what allows
+     * deep chains of co_awaiting coroutines to complete in constant stack space.
      *
-     * Finally, it destroys the just finished coroutine and frees all allocated resources.
+     * Finally, it releases the just finished coroutine's own reference, which destroys the
+     * coroutine frame if the associated Task no longer exists. In such case the last awaiting
+     * coroutine is resumed directly, before the frame is destroyed.
      *
      * \param[in] finishedCoroutine handle of the just finished coroutine
+     * \return handle of the coroutine to resume next, or a no-op coroutine handle if there
+     * is no coroutine awaiting the finished one.
      */
     template<typename Promise>
-    void await_suspend(std::coroutine_handle<Promise> finishedCoroutine) noexcept;
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> finishedCoroutine) noexcept;
 
     //! Called by the compiler when the just-finished coroutine should be resumed.
     /*!
@@ -67,9 +101,6 @@ public:
      * In any case, this method does nothing.
      * */
     constexpr void await_resume() const noexcept;
-
-private:
-    std::vector<std::coroutine_handle<>> mAwaitingCoroutines;
 };
 
 //! Base class for the \c Task<T> promise_type.
@@ -172,6 +203,28 @@ public:
     void refCoroutine();
     void destroyCoroutine();
 
+    //! Allocates the coroutine frame from the per-thread frame pool.
+    static void *operator new(std::size_t size);
+
+    //! Allocates the coroutine frame using an allocator passed to the coroutine.
+    /*!
+     * Called when the coroutine's first two arguments are \c std::allocator_arg and
+     * an allocator. A copy of the allocator is stored alongside the frame and is used
+     * to deallocate it.
+     */
+    template<typename Allocator, typename ... Args>
+    static void *operator new(std::size_t size, std::allocator_arg_t, const Allocator &allocator, const Args & ...);
+
+    //! \copydoc template<typename Allocator, typename ... Args> TaskPromiseBase::operator new(std::size_t, std::allocator_arg_t, const Allocator &, const Args & ...)
+    /*!
+     * Overload for member functions and lambdas, where the object is passed as the first argument.
+     */
+    template<typename This, typename Allocator, typename ... Args>
+    static void *operator new(std::size_t size, const This &, std::allocator_arg_t, const Allocator &allocator, const Args & ...);
+
+    //! Deallocates the coroutine frame, using the same allocator that has allocated it.
+    static void operator delete(void *ptr, std::size_t size) noexcept;
+
 protected:
     explicit TaskPromiseBase();
 
@@ -179,7 +232,14 @@ private:
     friend class TaskFinalSuspend;
 
     //! Handle of the coroutine that is currently co_awaiting this Awaitable
-    std::vector<std::coroutine_handle<>> mAwaitingCoroutines;
+    /*!
+     * Most coroutines are only ever co_awaited by a single coroutine, so the first awaiter
+     * is stored inline, without any allocation.
+     */
+    std::coroutine_handle<> mAwaitingCoroutine = {};
+
+    //! Handles of any additional coroutines co_awaiting this Awaitable, in the order they started awaiting.
+    std::vector<std::coroutine_handle<>> mAdditionalAwaitingCoroutines;
 
     //! Indicates whether we can destroy the coroutine handle
     std::atomic<uint32_t> mRefCount{0};
@@ -353,9 +413,6 @@ public:
     //! The task can be move-assigned.
     TaskBase &operator=(TaskBase &&other) noexcept;
 
-    //! Destructor.
-    virtual ~TaskBase();
-
     //! Returns whether the task has finished.
     /*!
      * A task that is ready (represents a finished coroutine) must not attempt
@@ -432,6 +489,13 @@ private:
     static auto thenImplRef(TaskT &task, ThenCallback &&thenCallback, ErrorCallback &&errorCallback) -> std::conditional_t<detail::isTask_v<R>, R, TaskImpl<R>>;
 
 protected:
+    //! Destructor.
+    /*!
+     * The destructor is intentionally not virtual, so that the task is just a coroutine handle
+     * without a vtable pointer. Tasks are never destroyed through a pointer to TaskBase.
+     */
+    ~TaskBase();
+
     std::coroutine_handle<PromiseType> mCoroutine = {};
 };
 
@@ -500,6 +564,41 @@ template <typename Awaitable>
 requires TaskConvertible<Awaitable>
 using convertible_awaitable_return_type_t = typename detail::awaitable_return_type<decltype(std::declval<TaskPromiseBase>().await_transform(Awaitable()))>::type;
 
+//! Result type of co_awaiting \c T inside a Task coroutine.
+template<typename T>
+using await_result_t = awaitable_return_type_t<std::remove_cvref_t<decltype(std::declval<TaskPromiseBase &>().await_transform(std::declval<T>()))>>;
+
+//! Result type of co_awaiting \c T for whenAll() and whenAny(), with \c void represented as \c std::monostate.
+template<typename T>
+using when_result_t = std::conditional_t<std::is_void_v<await_result_t<T>>, std::monostate, await_result_t<T>>;
+
+//! A range of values that can be co_awaited inside a Task coroutine.
+template<typename T>
+concept TaskConvertibleRange = requires(T &range) {
+    std::begin(range);
+    std::end(range);
+} && TaskConvertible<decltype(*std::begin(std::declval<T &>()))>;
+
+//! Type of the range elements passed to the coroutines awaiting them.
+/*!
+ * Elements of lvalue ranges are referenced, elements of rvalue ranges are moved.
+ */
+template<typename Range>
+using when_range_element_t = std::conditional_t<std::is_lvalue_reference_v<Range>,
+                                                decltype(*std::begin(std::declval<Range &>())),
+                                                std::remove_cvref_t<decltype(*std::begin(std::declval<Range &>()))>>;
+
+template<typename Range>
+using when_range_result_t = await_result_t<when_range_element_t<Range>>;
+
+template<typename Range>
+using when_all_range_result_t = std::conditional_t<std::is_void_v<when_range_result_t<Range>>,
+                                                   void, std::vector<when_range_result_t<Range>>>;
+
+template<typename Range>
+using when_any_range_result_t = std::conditional_t<std::is_void_v<when_range_result_t<Range>>,
+                                                   std::size_t, std::pair<std::size_t, when_range_result_t<Range>>>;
+
 } // namespace detail
 
 //! Waits for a coroutine to complete in a blocking manner.
@@ -544,8 +643,60 @@ requires detail::TaskConvertible<T>
         && (!detail::isTask_v<T>)
 void connect(T &&future, QObjectSubclass *context, Callback func);
 
+//! Concurrently awaits all the given awaitables.
+/*!
+ * All the awaitables (Tasks, LazyTasks or any type that can be co_awaited inside a Task
+ * coroutine, like QNetworkReply or QDBusPendingCall) are awaited concurrently and the
+ * returned Task finishes once all of them have finished.
+ *
+ * If any of the awaitables throws an exception, the exception is rethrown from the returned
+ * Task once all the awaitables have finished.
+ *
+ * \return A Task with a \c std::tuple of results of all the awaitables, in the order in
+ * which the awaitables were given. Results of awaitables that produce \c void are represented
+ * as \c std::monostate.
+ */
+template<typename ... Awaitables>
+requires (detail::TaskConvertible<Awaitables> && ...)
+auto whenAll(Awaitables && ... awaitables) -> Task<std::tuple<detail::when_result_t<Awaitables> ...>>;
+
+//! Concurrently awaits all awaitables in the given range.
+/*!
+ * If the range is an lvalue, the awaitables are awaited in place, so the range must outlive
+ * the returned Task. Otherwise the awaitables are moved out of the range.
+ *
+ * \return A Task with a \c std::vector of results of all the awaitables, in the order of the
+ * range, or \c Task<void> if the awaitables produce \c void.
+ */
+template<typename Range>
+requires detail::TaskConvertibleRange<Range>
+auto whenAll(Range &&awaitables) -> Task<detail::when_all_range_result_t<Range>>;
+
+//! Concurrently awaits all the given awaitables until the first one finishes.
+/*!
+ * The remaining awaitables are not cancelled, they keep running, but their results are discarded.
+ * If the first finished awaitable throws an exception, it is rethrown from the returned Task.
+ *
+ * \return A Task with a \c std::variant holding the result of the first finished awaitable, with
+ * \c std::variant::index() corresponding to the position of the awaitable in the argument list.
+ */
+template<typename ... Awaitables>
+requires (sizeof...(Awaitables) > 0 && (detail::TaskConvertible<Awaitables> && ...))
+auto whenAny(Awaitables && ... awaitables) -> Task<std::variant<detail::when_result_t<Awaitables> ...>>;
+
+//! Concurrently awaits all awaitables in the given range until the first one finishes.
+/*!
+ * \return A Task with a \c std::pair of index of the first finished awaitable in the range and
+ * its result, or just the index if the awaitables produce \c void. The returned Task throws
+ * \c std::invalid_argument if the range is empty.
+ */
+template<typename Range>
+requires detail::TaskConvertibleRange<Range>
+auto whenAny(Range &&awaitables) -> Task<detail::when_any_range_result_t<Range>>;
+
 } // namespace QCoro
 
+#include "impl/framepool.h"
 #include "impl/taskfinalsuspend.h"
 #include "impl/taskpromisebase.h"
 #include "impl/taskpromise.h"
@@ -554,3 +705,5 @@ void connect(T &&future, QObjectSubclass *context, Callback func);
 #include "impl/task.h"
 #include "impl/waitfor.h"
 #include "impl/connect.h"
+#include "impl/whenall.h"
+#include "impl/whenany.h"
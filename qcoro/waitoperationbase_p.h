@@ -6,9 +6,12 @@
 
 #include "macros_p.h"
 #include "coroutine.h"
+#include "qcoroexecutor.h"
+#include "impl/timerwheel.h"
 
-#include <QTimer>
-#include <memory>
+#include <QPointer>
+
+#include <chrono>
 
 namespace QCoro::detail {
 
@@ -26,41 +29,48 @@ public:
     }
 
 protected:
-    WaitOperationBase(T *obj, int timeout_msecs) : mObj{obj} {
-        if (timeout_msecs > -1) {
-            mTimeoutTimer = std::make_unique<QTimer>();
-            mTimeoutTimer->setInterval(timeout_msecs);
-            mTimeoutTimer->setSingleShot(true);
-        }
-    }
+    WaitOperationBase(T *obj, int timeout_msecs) : mObj{obj}, mTimeout{timeout_msecs} {}
 
     void startTimeoutTimer(std::coroutine_handle<> awaitingCoroutine) {
-        if (!mTimeoutTimer) {
+        if (mTimeout.count() < 0) {
             return;
         }
 
-        QObject::connect(mTimeoutTimer.get(), &QTimer::timeout,
-                         [this, awaitingCoroutine]() mutable {
-                             mTimedOut = true;
-                             resume(awaitingCoroutine);
-                         });
-        mTimeoutTimer->start();
+        mTimeoutEntry.callback = &WaitOperationBase::timedOut;
+        mTimeoutEntry.operation = this;
+        mTimeoutEntry.awaitingCoroutine = awaitingCoroutine;
+        TimerWheel::current().add(mTimeoutEntry, mTimeout);
     }
 
     void resume(std::coroutine_handle<> awaitingCoroutine) {
-        if (mTimeoutTimer) {
-            mTimeoutTimer->stop();
-        }
+        mTimeoutEntry.cancel();
 
         QObject::disconnect(mConn);
 
-        QTimer::singleShot(0, [awaitingCoroutine]() mutable { awaitingCoroutine.resume(); });
+        // Delayed trigger
+        mResumeNode.coroutine = awaitingCoroutine;
+        ThreadExecutor::current().post(mResumeNode);
     }
 
     QPointer<T> mObj;
-    std::unique_ptr<QTimer> mTimeoutTimer;
     QMetaObject::Connection mConn;
+    ScheduledCoroutine mResumeNode;
     bool mTimedOut = false;
+
+private:
+    struct Timeout : TimerEntry {
+        WaitOperationBase *operation = nullptr;
+        std::coroutine_handle<> awaitingCoroutine = {};
+    };
+
+    static void timedOut(TimerEntry *entry) {
+        auto *timeout = static_cast<Timeout *>(entry);
+        timeout->operation->mTimedOut = true;
+        timeout->operation->resume(timeout->awaitingCoroutine);
+    }
+
+    std::chrono::milliseconds mTimeout;
+    Timeout mTimeoutEntry;
 };
 
 } // namespace QCoro::detail
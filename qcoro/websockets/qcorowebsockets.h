@@ -6,3 +6,4 @@
 
 #include "qcorowebsocket.h"
 #include "qcorowebsocketserver.h"
+#include "qcorowebsocketworkerpool.h"
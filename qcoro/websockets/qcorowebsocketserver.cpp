@@ -5,6 +5,7 @@
 #include "qcorowebsocketserver.h"
 #include "qcorosignal.h"
 
+#include <QPointer>
 #include <QWebSocket>
 #include <QWebSocketServer>
 
@@ -28,6 +29,48 @@ Q_SIGNALS:
     void ready(QWebSocket *socket);
 };
 
+//! Wakes up the connections() generator when the server has new connections, is closed or is destroyed.
+class QCoroWebSocketServerWakeUpNotifier : public QObject {
+    Q_OBJECT
+public:
+    QCoroWebSocketServerWakeUpNotifier(QWebSocketServer *server) {
+        connect(server, &QWebSocketServer::closed, this, &QCoroWebSocketServerWakeUpNotifier::wokenUp);
+        connect(server, &QWebSocketServer::newConnection, this, &QCoroWebSocketServerWakeUpNotifier::wokenUp);
+        connect(server, &QObject::destroyed, this, &QCoroWebSocketServerWakeUpNotifier::wokenUp);
+    }
+
+Q_SIGNALS:
+    void wokenUp();
+};
+
+using WakeUpQueue = QCoroSignalQueue<QCoroWebSocketServerWakeUpNotifier,
+                                     decltype(&QCoroWebSocketServerWakeUpNotifier::wokenUp)>;
+
+QCoro::AsyncGenerator<QWebSocket *> pendingConnections(QPointer<QWebSocketServer> server,
+                                                       std::chrono::milliseconds timeout) {
+    if (!server) {
+        co_return;
+    }
+
+    // Both stay connected for the generator's whole lifetime, rather than connecting for every wait
+    QCoroWebSocketServerWakeUpNotifier notifier(server);
+    WakeUpQueue wakeUps(&notifier, &QCoroWebSocketServerWakeUpNotifier::wokenUp, timeout);
+    while (server && server->isListening()) {
+        // Accept everything that has queued up since the last wake-up before waiting again
+        while (server && server->hasPendingConnections()) {
+            co_yield server->nextPendingConnection();
+        }
+        if (!server || !server->isListening()) {
+            break;
+        }
+
+        const auto result = co_await wakeUps;
+        if (!result.has_value()) {
+            break;
+        }
+    }
+}
+
 } // namespace
 
 QCoroWebSocketServer::QCoroWebSocketServer(QWebSocketServer *server)
@@ -50,4 +93,9 @@ QCoro::Task<QWebSocket *> QCoroWebSocketServer::nextPendingConnection(std::chron
     co_return result.value_or(nullptr);
 }
 
+QCoro::AsyncGenerator<QWebSocket *> QCoroWebSocketServer::connections(std::chrono::milliseconds timeout)
+{
+    return pendingConnections(mServer, timeout);
+}
+
 #include "qcorowebsocketserver.moc"
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "qcoroasyncgenerator.h"
 #include "qcorotask.h"
 #include "qcorowebsockets_export.h"
 
@@ -20,12 +21,22 @@ public:
 
     Task<QWebSocket *> nextPendingConnection(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
 
+    //! Returns a generator that yields incoming connections as they arrive.
+    /*!
+     * Every time the generator wakes up, it yields all the pending connections, one after
+     * another, before it waits for the next one. A burst of incoming connections is thus
+     * accepted within a single wake-up of the generator, and the generator stays connected
+     * to the server's signals for its whole lifetime, rather than for each connection.
+     *
+     * The generator ends when the server is closed or when no new connection arrives within
+     * the \c timeout. If the \c timeout is -1, the generator never times out.
+     */
+    AsyncGenerator<QWebSocket *> connections(std::chrono::milliseconds timeout = std::chrono::milliseconds{-1});
+
 private:
     QWebSocketServer *mServer;
 };
 
-
-
 } // namespace QCoro::detail
 
 auto inline qCoro(QWebSocketServer *server) noexcept {
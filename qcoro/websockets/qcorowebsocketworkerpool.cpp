@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorowebsocketworkerpool.h"
+#include "qcoroconnectionworkerpool_p.h"
+
+#include <QWebSocket>
+
+using namespace QCoro;
+
+namespace {
+
+Task<> serveConnection(QWebSocket *socket, const WebSocketWorkerPool::ConnectionHandler &handler) {
+    co_await handler(socket);
+    socket->deleteLater();
+}
+
+} // namespace
+
+namespace QCoro::detail {
+
+class WebSocketWorkerPoolPrivate {
+public:
+    WebSocketWorkerPoolPrivate(WebSocketWorkerPool::ConnectionHandler handler, int workerCount)
+        : mHandler(std::move(handler))
+        , mWorkers(QStringLiteral("QCoro::WebSocketWorkerPool"), workerCount, [](QObject *socket) {
+            static_cast<QWebSocket *>(socket)->abort();
+        })
+    {}
+
+    const WebSocketWorkerPool::ConnectionHandler mHandler;
+    //! Destroyed first, waits for the handlers to finish.
+    ConnectionWorkerPool mWorkers;
+};
+
+} // namespace QCoro::detail
+
+WebSocketWorkerPool::WebSocketWorkerPool(ConnectionHandler handler, int workerCount)
+    : d(std::make_unique<detail::WebSocketWorkerPoolPrivate>(std::move(handler), workerCount))
+{}
+
+WebSocketWorkerPool::~WebSocketWorkerPool() = default;
+
+int WebSocketWorkerPool::workerCount() const {
+    return d->mWorkers.workerCount();
+}
+
+void WebSocketWorkerPool::dispatch(QWebSocket *socket) {
+    d->mWorkers.dispatch(socket, [socket, handler = &d->mHandler](QObject *) {
+        return serveConnection(socket, *handler);
+    });
+}
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "qcorotask.h"
+#include "qcorowebsockets_export.h"
+
+#include <functional>
+#include <memory>
+
+class QWebSocket;
+
+namespace QCoro {
+
+namespace detail {
+class WebSocketWorkerPoolPrivate;
+} // namespace detail
+
+//! Serves accepted QWebSocket connections on a pool of worker threads.
+/*!
+ * QWebSocketServer performs the handshake of every connection in its own thread. Once a
+ * connection is accepted, dispatch() moves the QWebSocket to one of the pool's worker threads,
+ * in a round-robin fashion, and calls the connection handler coroutine for it there. Each
+ * worker runs its own event loop, so the traffic of the connections is spread over all the
+ * workers, while the server's thread only accepts new connections.
+ *
+ * ```cpp
+ * QCoro::WebSocketWorkerPool workers([](QWebSocket *socket) -> QCoro::Task<> {
+ *     QCORO_FOREACH(const QString &message, qCoro(socket).textMessages()) {
+ *         socket->sendTextMessage(handleMessage(message));
+ *     }
+ * });
+ * QCORO_FOREACH(QWebSocket *socket, qCoro(server).connections()) {
+ *     workers.dispatch(socket);
+ * }
+ * ```
+ *
+ * The handler is called from all the worker threads concurrently, so it must be thread-safe.
+ */
+class QCOROWEBSOCKETS_EXPORT WebSocketWorkerPool {
+public:
+    //! Coroutine serving a single connection.
+    using ConnectionHandler = std::function<Task<>(QWebSocket *)>;
+
+    //! Creates a pool serving the connections with the \c handler on \c workerCount threads.
+    /*!
+     * If \c workerCount is 0, the pool creates one worker per CPU core.
+     */
+    explicit WebSocketWorkerPool(ConnectionHandler handler, int workerCount = 0);
+
+    //! Stops the worker threads.
+    /*!
+     * Connections that are still open, including those dispatched but not yet served, are
+     * aborted and the destructor waits for their handlers to finish, so the handlers must
+     * return once their socket is closed.
+     */
+    ~WebSocketWorkerPool();
+    WebSocketWorkerPool(const WebSocketWorkerPool &) = delete;
+    WebSocketWorkerPool &operator=(const WebSocketWorkerPool &) = delete;
+    WebSocketWorkerPool(WebSocketWorkerPool &&) = delete;
+    WebSocketWorkerPool &operator=(WebSocketWorkerPool &&) = delete;
+
+    //! Returns the number of worker threads.
+    int workerCount() const;
+
+    //! Moves the \c socket to the next worker thread and serves it there with the handler.
+    /*!
+     * Must be called from the thread the \c socket lives in. The pool takes ownership of the
+     * \c socket, it is deleted in the worker thread once the Task returned by the handler
+     * finishes.
+     */
+    void dispatch(QWebSocket *socket);
+
+private:
+    std::unique_ptr<detail::WebSocketWorkerPoolPrivate> d;
+};
+
+} // namespace QCoro
@@ -338,6 +338,25 @@ private:
         QVERIFY(mServer.waitForConnection());
     }
 
+    QCoro::Task<> testChunksAfterDisconnect_coro(QCoro::TestContext) {
+        QTcpSocket socket;
+        co_await qCoro(socket).connectToHost(QHostAddress::LocalHost, mServer.port());
+        QCORO_COMPARE(socket.state(), QAbstractSocket::ConnectedState);
+
+        socket.write("GET /ping HTTP/1.1\r\n");
+        co_await qCoro(socket).waitForDisconnected();
+        QCORO_COMPARE(socket.state(), QAbstractSocket::UnconnectedState);
+
+        // The read channel finished before the generator was created, so it must end right
+        // after reading the buffered data rather than waiting for more.
+        QByteArray data;
+        QCORO_FOREACH(const QByteArray &chunk, qCoro(socket).chunks(16)) {
+            data += chunk;
+        }
+        QCORO_VERIFY(data.endsWith("abcdef"));
+        QCORO_VERIFY(mServer.waitForConnection());
+    }
+
 private Q_SLOTS:
     void init() {
         mServer.start(QHostAddress::LocalHost);
@@ -357,6 +376,7 @@ private Q_SLOTS:
     addCoroAndThenTests(ReadAllTriggers)
     addCoroAndThenTests(ReadTriggers)
     addCoroAndThenTests(ReadLineTriggers)
+    addTest(ChunksAfterDisconnect)
 
 private:
     TestHttpServer<QTcpServer> mServer;
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "qcorocancellationtoken.h"
+
+#include <QTest>
+#include <QObject>
+#include <QThread>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+
+class QCoroCancellationTokenTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testDefaultTokenIsNeverCancelled() {
+        const QCoro::CancellationToken token;
+        QVERIFY(!token.canBeCancelled());
+        QVERIFY(!token.isCancellationRequested());
+
+        bool called = false;
+        QCoro::CancellationCallback callback(token, [&called]() { called = true; });
+        QVERIFY(!called);
+    }
+
+    void testRequestCancellation() {
+        QCoro::CancellationSource source;
+        const auto token = source.token();
+        QVERIFY(token.canBeCancelled());
+        QVERIFY(!token.isCancellationRequested());
+
+        QVERIFY(source.requestCancellation());
+        QVERIFY(source.isCancellationRequested());
+        QVERIFY(token.isCancellationRequested());
+        QVERIFY(source.token().isCancellationRequested());
+
+        // Only the first request has any effect
+        QVERIFY(!source.requestCancellation());
+    }
+
+    void testCallbacksInvoked() {
+        QCoro::CancellationSource source;
+        int called = 0;
+        QCoro::CancellationCallback first(source.token(), [&called]() { ++called; });
+        QCoro::CancellationCallback second(source.token(), [&called]() { ++called; });
+        {
+            QCoro::CancellationCallback unregistered(source.token(), [&called]() { ++called; });
+        }
+
+        source.requestCancellation();
+        QCOMPARE(called, 2);
+
+        source.requestCancellation();
+        QCOMPARE(called, 2);
+    }
+
+    void testCallbackInvokedImmediatelyWhenAlreadyCancelled() {
+        QCoro::CancellationSource source;
+        source.requestCancellation();
+
+        bool called = false;
+        QCoro::CancellationCallback callback(source.token(), [&called]() { called = true; });
+        QVERIFY(called);
+    }
+
+    void testCallbackDestroysItself() {
+        QCoro::CancellationSource source;
+        int called = 0;
+        std::optional<QCoro::CancellationCallback<std::function<void()>>> callback;
+        callback.emplace(source.token(), [&]() {
+            ++called;
+            callback.reset();
+        });
+
+        source.requestCancellation();
+        QCOMPARE(called, 1);
+        QVERIFY(!callback.has_value());
+    }
+
+    void testCancellationFromDifferentThread() {
+        for (int i = 0; i < 100; ++i) {
+            QCoro::CancellationSource source;
+            std::atomic<int> called{0};
+            std::unique_ptr<QThread> thread(QThread::create([source]() mutable {
+                source.requestCancellation();
+            }));
+            thread->start();
+            {
+                QCoro::CancellationCallback callback(source.token(), [&called]() { ++called; });
+            }
+            thread->wait();
+            QVERIFY(called <= 1);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(QCoroCancellationTokenTest)
+
+#include "qcorocancellationtoken.moc"
@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+#include "qcorochannel.h"
+#include "qcoro/core/qcorothreadpool.h"
+
+#include <QTimer>
+
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+template<typename Channel>
+QCoro::Task<> sendRange(Channel &channel, int from, int to) {
+    for (int i = from; i < to; ++i) {
+        co_await channel.send(i);
+    }
+}
+
+template<typename Channel>
+QCoro::Task<> produceOnPool(QCoro::ThreadPool &pool, Channel &channel, int from, int to) {
+    co_await pool.schedule();
+    for (int i = from; i < to; ++i) {
+        const bool sent = co_await channel.send(std::make_unique<int>(i), pool);
+        Q_ASSERT(sent);
+    }
+}
+
+template<typename Channel>
+QCoro::Task<qint64> consumeOnPool(QCoro::ThreadPool &pool, Channel &channel) {
+    co_await pool.schedule();
+    qint64 sum = 0;
+    while (const auto value = co_await channel.receive(pool)) {
+        sum += **value;
+    }
+    co_return sum;
+}
+
+template<QCoro::ChannelMode mode>
+QCoro::Task<> testAcrossThreads(int producers, int consumers) {
+    constexpr int valuesPerProducer = 10000;
+    QCoro::ThreadPool pool(4);
+    auto &origin = QCoro::ThreadExecutor::current();
+    QCoro::Channel<std::unique_ptr<int>, mode> channel(8);
+
+    std::vector<QCoro::Task<qint64>> consumerTasks;
+    for (int i = 0; i < consumers; ++i) {
+        consumerTasks.push_back(consumeOnPool(pool, channel));
+    }
+    std::vector<QCoro::Task<>> producerTasks;
+    for (int i = 0; i < producers; ++i) {
+        producerTasks.push_back(produceOnPool(pool, channel, i * valuesPerProducer, (i + 1) * valuesPerProducer));
+    }
+
+    co_await QCoro::whenAll(producerTasks);
+    channel.close();
+    const auto sums = co_await QCoro::whenAll(consumerTasks);
+    co_await origin.schedule();
+
+    const qint64 count = qint64{producers} * valuesPerProducer;
+    qint64 total = 0;
+    for (const auto sum : sums) {
+        total += sum;
+    }
+    QCORO_COMPARE(total, count * (count - 1) / 2);
+}
+
+} // namespace
+
+class QCoroChannelTest : public QCoro::TestObject<QCoroChannelTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testTrySendReceive_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+
+        QCoro::Channel<int> channel(2);
+        QCORO_COMPARE(channel.capacity(), std::size_t{2});
+        QCORO_VERIFY(channel.trySend(1));
+        QCORO_VERIFY(channel.trySend(2));
+        QCORO_VERIFY(!channel.trySend(3));
+        QCORO_COMPARE(channel.size(), std::size_t{2});
+
+        QCORO_COMPARE(channel.tryReceive(), std::optional<int>{1});
+        const auto value = co_await channel.receive();
+        QCORO_COMPARE(value, std::optional<int>{2});
+        QCORO_COMPARE(channel.tryReceive(), std::optional<int>{});
+    }
+
+    QCoro::Task<> testSendSuspendsWhenFull_coro(QCoro::TestContext) {
+        QCoro::Channel<int> channel(2);
+        auto producer = sendRange(channel, 0, 5);
+        // The producer is suspended once the channel is full
+        QCORO_VERIFY(!producer.isReady());
+        QCORO_COMPARE(channel.size(), std::size_t{2});
+
+        std::vector<int> values;
+        for (int i = 0; i < 5; ++i) {
+            const auto value = co_await channel.receive();
+            QCORO_VERIFY(value.has_value());
+            values.push_back(*value);
+        }
+        co_await producer;
+        QCORO_COMPARE(values, (std::vector<int>{0, 1, 2, 3, 4}));
+    }
+
+    QCoro::Task<> testReceiveSuspendsWhenEmpty_coro(QCoro::TestContext) {
+        QCoro::Channel<QString> channel(1);
+        QTimer::singleShot(10ms, [&channel]() { QVERIFY(channel.trySend(QStringLiteral("Hello"))); });
+
+        const auto value = co_await channel.receive();
+        QCORO_COMPARE(value, std::optional<QString>{QStringLiteral("Hello")});
+    }
+
+    QCoro::Task<> testClose_coro(QCoro::TestContext) {
+        QCoro::Channel<int> channel(1);
+        QCORO_VERIFY(channel.trySend(1));
+
+        const auto blockedSend = [&]() -> QCoro::Task<bool> { co_return co_await channel.send(2); };
+        auto sender = blockedSend();
+        QCORO_VERIFY(!sender.isReady());
+
+        channel.close();
+        QCORO_VERIFY(channel.isClosed());
+        // The suspended sender is resumed without sending its value
+        const bool sent = co_await sender;
+        QCORO_VERIFY(!sent);
+        QCORO_VERIFY(!channel.trySend(3));
+
+        // Values sent before closing can still be received
+        const auto first = co_await channel.receive();
+        QCORO_COMPARE(first, std::optional<int>{1});
+        const auto second = co_await channel.receive();
+        QCORO_COMPARE(second, std::optional<int>{});
+    }
+
+    QCoro::Task<> testCloseResumesReceivers_coro(QCoro::TestContext) {
+        QCoro::Channel<int> channel(1);
+        QTimer::singleShot(10ms, [&channel]() { channel.close(); });
+
+        const auto value = co_await channel.receive();
+        QCORO_COMPARE(value, std::optional<int>{});
+    }
+
+    QCoro::Task<> testReceiveAll_coro(QCoro::TestContext) {
+        QCoro::Channel<int> channel(3);
+        const auto producer = [&]() -> QCoro::Task<> {
+            co_await sendRange(channel, 0, 10);
+            channel.close();
+        };
+        auto producerTask = producer();
+
+        std::vector<int> values;
+        QCORO_FOREACH(int value, channel.receiveAll()) {
+            values.push_back(value);
+        }
+        co_await producerTask;
+        QCORO_COMPARE(values, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+
+    QCoro::Task<> testSpscAcrossThreads_coro(QCoro::TestContext) {
+        co_await testAcrossThreads<QCoro::ChannelMode::SingleProducerSingleConsumer>(1, 1);
+    }
+
+    QCoro::Task<> testMpmcAcrossThreads_coro(QCoro::TestContext) {
+        co_await testAcrossThreads<QCoro::ChannelMode::MultiProducerMultiConsumer>(4, 4);
+    }
+
+private Q_SLOTS:
+    addTest(TrySendReceive)
+    addTest(SendSuspendsWhenFull)
+    addTest(ReceiveSuspendsWhenEmpty)
+    addTest(Close)
+    addTest(CloseResumesReceivers)
+    addTest(ReceiveAll)
+    addTest(SpscAcrossThreads)
+    addTest(MpmcAcrossThreads)
+
+    void benchmarkSpscThroughput() {
+        constexpr int valueCount = 100'000;
+        QCoro::ThreadPool pool(2);
+        QBENCHMARK {
+            QCoro::Channel<int, QCoro::ChannelMode::SingleProducerSingleConsumer> channel(64);
+            const auto producer = [&]() -> QCoro::Task<> {
+                co_await pool.schedule();
+                for (int i = 0; i < valueCount; ++i) {
+                    co_await channel.send(i, pool);
+                }
+                channel.close();
+            };
+            const auto consumer = [&]() -> QCoro::Task<int> {
+                co_await pool.schedule();
+                int count = 0;
+                while (co_await channel.receive(pool)) {
+                    ++count;
+                }
+                co_return count;
+            };
+            const auto run = [&]() -> QCoro::Task<int> {
+                auto &origin = QCoro::ThreadExecutor::current();
+                const auto results = co_await QCoro::whenAll(producer(), consumer());
+                co_await origin.schedule();
+                co_return std::get<1>(results);
+            };
+            QCOMPARE(QCoro::waitFor(run()), valueCount);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(QCoroChannelTest)
+
+#include "qcorochannel.moc"
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+#include "qcoroconditionvariable.h"
+#include "qcorotimer.h"
+
+#include <QQueue>
+
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class QCoroConditionVariableTest : public QCoro::TestObject<QCoroConditionVariableTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testNotifyOne_coro(QCoro::TestContext) {
+        QCoro::Mutex mutex;
+        QCoro::ConditionVariable condition;
+        QQueue<int> queue;
+
+        const auto consumer = [&]() -> QCoro::Task<int> {
+            auto locker = co_await mutex.scopedLock();
+            co_await condition.wait(mutex, [&queue]() { return !queue.empty(); });
+            co_return queue.dequeue();
+        };
+        auto first = consumer();
+        auto second = consumer();
+        // Both consumers are waiting, with the mutex unlocked
+        QCORO_VERIFY(!mutex.isLocked());
+
+        co_await QCoro::sleepFor(10ms);
+        {
+            const auto locker = co_await mutex.scopedLock();
+            queue.enqueue(42);
+        }
+        condition.notifyOne();
+        const int firstValue = co_await first;
+        QCORO_COMPARE(firstValue, 42);
+        QCORO_VERIFY(!second.isReady());
+
+        {
+            const auto locker = co_await mutex.scopedLock();
+            queue.enqueue(43);
+        }
+        condition.notifyOne();
+        const int secondValue = co_await second;
+        QCORO_COMPARE(secondValue, 43);
+        QCORO_VERIFY(!mutex.isLocked());
+    }
+
+    QCoro::Task<> testNotifyAll_coro(QCoro::TestContext) {
+        QCoro::Mutex mutex;
+        QCoro::ConditionVariable condition;
+        bool ready = false;
+        int resumed = 0;
+
+        const auto waiter = [&]() -> QCoro::Task<> {
+            const auto locker = co_await mutex.scopedLock();
+            while (!ready) {
+                co_await condition.wait(mutex);
+            }
+            ++resumed;
+        };
+        std::vector<QCoro::Task<>> tasks;
+        for (int i = 0; i < 5; ++i) {
+            tasks.push_back(waiter());
+        }
+
+        {
+            const auto locker = co_await mutex.scopedLock();
+            ready = true;
+            // Notified while the mutex is still held, the waiters get it one by one afterwards
+            condition.notifyAll();
+        }
+        co_await QCoro::whenAll(tasks);
+        QCORO_COMPARE(resumed, 5);
+        QCORO_VERIFY(!mutex.isLocked());
+    }
+
+private Q_SLOTS:
+    addTest(NotifyOne)
+    addTest(NotifyAll)
+};
+
+QTEST_GUILESS_MAIN(QCoroConditionVariableTest)
+
+#include "qcoroconditionvariable.moc"
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+#include "qcoroevent.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QTimer>
+
+#include <memory>
+
+using namespace std::chrono_literals;
+
+class QCoroEventTest : public QCoro::TestObject<QCoroEventTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testWaitForSetEvent_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+
+        QCoro::Event event(QCoro::Event::ResetMode::Manual, true);
+        co_await event.wait();
+        co_await event.wait();
+        QCORO_VERIFY(event.isSet());
+    }
+
+    QCoro::Task<> testManualReset_coro(QCoro::TestContext) {
+        QCoro::Event event;
+        QCORO_VERIFY(!event.isSet());
+        QCORO_COMPARE(event.resetMode(), QCoro::Event::ResetMode::Manual);
+
+        int resumed = 0;
+        const auto waiter = [&]() -> QCoro::Task<> {
+            co_await event.wait();
+            ++resumed;
+        };
+        auto first = waiter();
+        auto second = waiter();
+
+        QTimer::singleShot(10ms, [&event]() { event.set(); });
+        co_await QCoro::whenAll(first, second);
+        QCORO_COMPARE(resumed, 2);
+        QCORO_VERIFY(event.isSet());
+
+        event.reset();
+        QCORO_VERIFY(!event.isSet());
+    }
+
+    QCoro::Task<> testAutomaticReset_coro(QCoro::TestContext) {
+        QCoro::Event event(QCoro::Event::ResetMode::Automatic);
+
+        int resumed = 0;
+        const auto waiter = [&]() -> QCoro::Task<> {
+            co_await event.wait();
+            ++resumed;
+        };
+        auto first = waiter();
+        auto second = waiter();
+
+        event.set();
+        co_await first;
+        QCORO_COMPARE(resumed, 1);
+        QCORO_VERIFY(!second.isReady());
+        QCORO_VERIFY(!event.isSet());
+
+        event.set();
+        co_await second;
+        QCORO_COMPARE(resumed, 2);
+
+        // With no coroutine waiting, the event stays set until the next wait
+        event.set();
+        QCORO_VERIFY(event.isSet());
+        co_await event.wait();
+        QCORO_VERIFY(!event.isSet());
+    }
+
+    QCoro::Task<> testSetFromOtherThread_coro(QCoro::TestContext) {
+        QCoro::Event event;
+        std::unique_ptr<QThread> thread(QThread::create([&event]() {
+            QThread::msleep(10);
+            event.set();
+        }));
+        thread->start();
+
+        co_await event.wait();
+        // Resumed in the thread that started waiting
+        QCORO_COMPARE(QThread::currentThread(), QCoreApplication::instance()->thread());
+        thread->wait();
+    }
+
+private Q_SLOTS:
+    addTest(WaitForSetEvent)
+    addTest(ManualReset)
+    addTest(AutomaticReset)
+    addTest(SetFromOtherThread)
+};
+
+QTEST_GUILESS_MAIN(QCoroEventTest)
+
+#include "qcoroevent.moc"
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+#include "qcoroexecutor.h"
+#include "qcorotask.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QTimer>
+
+#include <numeric>
+#include <vector>
+
+namespace {
+
+QCoro::Task<> scheduleAndRecord(QCoro::Executor &executor, std::vector<int> &order, int value) {
+    co_await executor.schedule();
+    order.push_back(value);
+}
+
+QCoro::Task<> scheduleAndCount(QCoro::Executor &executor, int &counter) {
+    co_await executor.schedule();
+    ++counter;
+}
+
+constexpr int benchmarkCoroutines = 1000;
+
+} // namespace
+
+class QCoroExecutorTest : public QCoro::TestObject<QCoroExecutorTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testScheduleOnCurrentThread_coro(QCoro::TestContext) {
+        auto &executor = QCoro::ThreadExecutor::current();
+        QCORO_COMPARE(executor.thread(), QThread::currentThread());
+
+        bool resumed = false;
+        QTimer::singleShot(0, this, [&resumed]() { resumed = true; });
+        co_await executor.schedule();
+        // Resumed from the event loop, not from within schedule()
+        QCORO_VERIFY(resumed);
+        QCORO_COMPARE(QThread::currentThread(), executor.thread());
+    }
+
+    QCoro::Task<> testResumeOrder_coro(QCoro::TestContext) {
+        std::vector<int> order;
+        std::vector<QCoro::Task<>> tasks;
+        for (int i = 0; i < 100; ++i) {
+            tasks.push_back(scheduleAndRecord(QCoro::ThreadExecutor::current(), order, i));
+        }
+        QCORO_VERIFY(order.empty());
+
+        co_await QCoro::whenAll(tasks);
+
+        std::vector<int> expected(100);
+        std::iota(expected.begin(), expected.end(), 0);
+        QCORO_COMPARE(order, expected);
+    }
+
+    QCoro::Task<> testScheduleOnOtherThread_coro(QCoro::TestContext) {
+        QThread thread;
+        thread.start();
+
+        auto &mainExecutor = QCoro::ThreadExecutor::current();
+        {
+            QCoro::ThreadExecutor executor(&thread);
+            QCORO_COMPARE(executor.thread(), &thread);
+
+            co_await executor.schedule();
+            QCORO_COMPARE(QThread::currentThread(), &thread);
+
+            co_await mainExecutor.schedule();
+            QCORO_COMPARE(QThread::currentThread(), QCoreApplication::instance()->thread());
+        }
+
+        thread.exit();
+        thread.wait();
+    }
+
+    QCoro::Task<> testSharedExecutor_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+
+        QCORO_COMPARE(&QCoro::ThreadExecutor::forThread(QThread::currentThread()), &QCoro::ThreadExecutor::current());
+
+        QThread thread;
+        auto &executor = QCoro::ThreadExecutor::forThread(&thread);
+        QCORO_COMPARE(&QCoro::ThreadExecutor::forThread(&thread), &executor);
+        QCORO_COMPARE(executor.thread(), &thread);
+    }
+
+    QCoro::Task<> testInlineExecutor_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+
+        const auto *thread = QThread::currentThread();
+        co_await QCoro::InlineExecutor::instance().schedule();
+        QCORO_COMPARE(QThread::currentThread(), thread);
+    }
+
+private Q_SLOTS:
+    addTest(ScheduleOnCurrentThread)
+    addTest(ResumeOrder)
+    addTest(ScheduleOnOtherThread)
+    addTest(SharedExecutor)
+    addTest(InlineExecutor)
+
+    void benchmarkThreadExecutor() {
+        int counter = 0;
+        QBENCHMARK {
+            counter = 0;
+            std::vector<QCoro::Task<>> tasks;
+            tasks.reserve(benchmarkCoroutines);
+            for (int i = 0; i < benchmarkCoroutines; ++i) {
+                tasks.push_back(scheduleAndCount(QCoro::ThreadExecutor::current(), counter));
+            }
+            while (counter < benchmarkCoroutines) {
+                QCoreApplication::processEvents();
+            }
+        }
+    }
+
+    // Baseline for benchmarkThreadExecutor(): how the awaiters used to resume coroutines.
+    void benchmarkSingleShotTimer() {
+        int counter = 0;
+        QBENCHMARK {
+            counter = 0;
+            for (int i = 0; i < benchmarkCoroutines; ++i) {
+                QTimer::singleShot(0, [&counter]() { ++counter; });
+            }
+            while (counter < benchmarkCoroutines) {
+                QCoreApplication::processEvents();
+            }
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(QCoroExecutorTest)
+
+#include "qcoroexecutor.moc"
@@ -0,0 +1,290 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+#include "pipedevice.h"
+
+#include "qcoro/core/qcoroframedstream.h"
+#include "qcoro/core/qcoroiodevice.h"
+#include "qcoro/core/qcoroprocess.h"
+#include "qcoro/core/qcorotimer.h"
+
+#include <QBuffer>
+#include <QList>
+#include <QProcess>
+#include <QTimer>
+#include <QtEndian>
+
+using namespace std::chrono_literals;
+using QCoro::FramedStream;
+
+class QCoroFramedStreamTest : public QCoro::TestObject<QCoroFramedStreamTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testRoundTrip_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        const QList<QByteArray> frames = {QByteArray(), QByteArray("a"), QByteArray(300, 'b'),
+                                          QByteArray(10'000, 'c')};
+        for (const auto lengthPrefix : {FramedStream::LengthPrefix::UInt16, FramedStream::LengthPrefix::UInt32,
+                                        FramedStream::LengthPrefix::UInt64, FramedStream::LengthPrefix::Varint}) {
+            QByteArray data;
+            QBuffer output(&data);
+            output.open(QIODevice::WriteOnly);
+            FramedStream writer(&output, lengthPrefix);
+            for (const auto &frame : frames) {
+                QCORO_VERIFY(co_await writer.sendFrame(frame));
+            }
+            QCORO_VERIFY(writer.flush());
+
+            QBuffer input(&data);
+            input.open(QIODevice::ReadOnly);
+            FramedStream reader(&input, lengthPrefix);
+            QList<QByteArray> received;
+            QCORO_FOREACH(const QByteArray &frame, reader.frames()) {
+                received.push_back(frame);
+            }
+            QCORO_COMPARE(received, frames);
+            QCORO_COMPARE(reader.error(), FramedStream::Error::NoError);
+        }
+    }
+
+    QCoro::Task<> testLengthPrefixEncoding_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        const QByteArray frame(300, 'x');
+
+        PipeDevice fixed(QIODevice::ReadWrite);
+        FramedStream fixedStream(&fixed, FramedStream::LengthPrefix::UInt32);
+        co_await fixedStream.sendFrame(frame);
+        fixedStream.flush();
+        QCORO_COMPARE(fixed.written.left(4), QByteArray("\x00\x00\x01\x2c", 4));
+
+        PipeDevice varint(QIODevice::ReadWrite);
+        FramedStream varintStream(&varint, FramedStream::LengthPrefix::Varint);
+        co_await varintStream.sendFrame(frame);
+        varintStream.flush();
+        QCORO_COMPARE(varint.written.left(2), QByteArray("\xac\x02", 2));
+        QCORO_COMPARE(varint.written.size(), 302);
+    }
+
+    QCoro::Task<> testFramesAcrossReads_coro(QCoro::TestContext) {
+        PipeDevice device;
+        // The varint prefix of the first frame as well as its payload are split
+        QTimer::singleShot(10ms, &device, [&device]() { device.feed(QByteArray("\xac", 1)); });
+        QTimer::singleShot(20ms, &device, [&device]() { device.feed(QByteArray("\x02", 1) + QByteArray(100, 'a')); });
+        QTimer::singleShot(30ms, &device, [&device]() { device.feed(QByteArray(200, 'a') + QByteArray("\x02hi", 3)); });
+        QTimer::singleShot(40ms, &device, [&device]() { device.close(); });
+
+        FramedStream stream(&device, FramedStream::LengthPrefix::Varint);
+        QList<QByteArray> received;
+        QCORO_FOREACH(const QByteArray &frame, stream.frames()) {
+            received.push_back(frame);
+        }
+        QCORO_COMPARE(received, (QList<QByteArray>{QByteArray(300, 'a'), QByteArray("hi")}));
+        QCORO_COMPARE(stream.error(), FramedStream::Error::NoError);
+    }
+
+    QCoro::Task<> testFrameTooLarge_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        QByteArray data;
+        QBuffer output(&data);
+        output.open(QIODevice::WriteOnly);
+        FramedStream writer(&output);
+        co_await writer.sendFrame(QByteArray(10, 'a'));
+        co_await writer.sendFrame(QByteArray(300, 'b'));
+        writer.flush();
+
+        QBuffer input(&data);
+        input.open(QIODevice::ReadOnly);
+        FramedStream reader(&input, FramedStream::LengthPrefix::UInt32, 100);
+        QList<QByteArray> received;
+        QCORO_FOREACH(const QByteArray &frame, reader.frames()) {
+            received.push_back(frame);
+        }
+        QCORO_COMPARE(received, QList<QByteArray>{QByteArray(10, 'a')});
+        QCORO_COMPARE(reader.error(), FramedStream::Error::FrameTooLarge);
+        // The payload of the too large frame is not consumed
+        QCORO_COMPARE(input.bytesAvailable(), qint64{4 + 300});
+
+        // Neither is a too large frame sent
+        FramedStream limitedWriter(&output, FramedStream::LengthPrefix::UInt32, 100);
+        QCORO_VERIFY(!co_await limitedWriter.sendFrame(QByteArray(300, 'b')));
+    }
+
+    QCoro::Task<> testFrameTooLargeForPrefix_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        QByteArray data;
+        QBuffer output(&data);
+        output.open(QIODevice::WriteOnly);
+        // The default limit is larger than what a 16-bit prefix can encode
+        FramedStream writer(&output, FramedStream::LengthPrefix::UInt16);
+        QCORO_COMPARE(writer.maxFrameSize(), qint64{65535});
+        QCORO_VERIFY(!co_await writer.sendFrame(QByteArray(100'000, 'a')));
+        QCORO_VERIFY(co_await writer.sendFrame(QByteArray(65535, 'b')));
+        QCORO_VERIFY(writer.flush());
+        QCORO_COMPARE(data.size(), 2 + 65535);
+
+        QBuffer input(&data);
+        input.open(QIODevice::ReadOnly);
+        FramedStream reader(&input, FramedStream::LengthPrefix::UInt16);
+        QList<QByteArray> received;
+        QCORO_FOREACH(const QByteArray &frame, reader.frames()) {
+            received.push_back(frame);
+        }
+        QCORO_COMPARE(received, QList<QByteArray>{QByteArray(65535, 'b')});
+        QCORO_COMPARE(reader.error(), FramedStream::Error::NoError);
+    }
+
+    QCoro::Task<> testMalformedVarint_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        QByteArray data(11, '\xff');
+        QBuffer input(&data);
+        input.open(QIODevice::ReadOnly);
+
+        FramedStream reader(&input, FramedStream::LengthPrefix::Varint);
+        QCORO_FOREACH(const QByteArray &frame, reader.frames()) {
+            Q_UNUSED(frame);
+            QCORO_FAIL("No frame expected");
+        }
+        QCORO_COMPARE(reader.error(), FramedStream::Error::MalformedLengthPrefix);
+    }
+
+    QCoro::Task<> testTruncatedFrame_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        QByteArray data("\x00\x00\x00\x0a" "abcde", 9);
+        QBuffer input(&data);
+        input.open(QIODevice::ReadOnly);
+
+        FramedStream reader(&input);
+        QCORO_FOREACH(const QByteArray &frame, reader.frames()) {
+            Q_UNUSED(frame);
+            QCORO_FAIL("No frame expected");
+        }
+        QCORO_COMPARE(reader.error(), FramedStream::Error::TruncatedFrame);
+    }
+
+    QCoro::Task<> testTruncatedFrameOfFinishedDevice_coro(QCoro::TestContext) {
+        QProcess process;
+#ifdef Q_OS_WIN
+        process.start(QStringLiteral("cmd"), {QStringLiteral("/c"), QStringLiteral("echo abcde")});
+#else
+        process.start(QStringLiteral("echo"), {QStringLiteral("abcde")});
+#endif
+        QCORO_VERIFY(co_await qCoro(process).waitForFinished());
+
+        // The process is still open with the output buffered, "ab" is a prefix of a much longer frame
+        FramedStream reader(&process, FramedStream::LengthPrefix::UInt16);
+        QCORO_FOREACH(const QByteArray &frame, reader.frames()) {
+            Q_UNUSED(frame);
+            QCORO_FAIL("No frame expected");
+        }
+        QCORO_COMPARE(reader.error(), FramedStream::Error::TruncatedFrame);
+    }
+
+    QCoro::Task<> testSendFrameBatches_coro(QCoro::TestContext) {
+        PipeDevice device(QIODevice::ReadWrite);
+        FramedStream stream(&device);
+        for (int i = 0; i < 100; ++i) {
+            QCORO_VERIFY(co_await stream.sendFrame(QByteArray::number(i)));
+        }
+        // Nothing is written until the control returns to the event loop
+        QCORO_COMPARE(device.writeCount, 0);
+
+        co_await QCoro::sleepFor(10ms);
+        QCORO_COMPARE(device.writeCount, 1);
+
+        QBuffer input(&device.written);
+        input.open(QIODevice::ReadOnly);
+        FramedStream reader(&input);
+        int count = 0;
+        QCORO_FOREACH(const QByteArray &frame, reader.frames()) {
+            QCORO_COMPARE(frame, QByteArray::number(count));
+            ++count;
+        }
+        QCORO_COMPARE(count, 100);
+    }
+
+    QCoro::Task<> testFlushesOnDestruction_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        PipeDevice device(QIODevice::ReadWrite);
+        {
+            FramedStream stream(&device);
+            QCORO_VERIFY(co_await stream.sendFrame("hello"));
+            QCORO_COMPARE(device.writeCount, 0);
+        }
+        // The batched frame is written by the destructor rather than dropped
+        QCORO_COMPARE(device.written, QByteArray("\x00\x00\x00\x05" "hello", 9));
+    }
+
+    QCoro::Task<> testLargeFrameNotBatched_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        PipeDevice device(QIODevice::ReadWrite);
+        FramedStream stream(&device);
+        co_await stream.sendFrame("small");
+        co_await stream.sendFrame(QByteArray(100'000, 'x'));
+        // The batched frame and prefix are written before the large frame, which is written as is
+        QCORO_COMPARE(device.writeCount, 2);
+        QCORO_COMPARE(device.written.size(), 4 + 5 + 4 + 100'000);
+    }
+
+    QCoro::Task<> readFrames(QIODevice &device) {
+        FramedStream stream(&device);
+        QCORO_FOREACH(const QByteArray &frame, stream.frames()) {
+            Q_UNUSED(frame);
+        }
+    }
+
+    QCoro::Task<> readFramesWithRead(QIODevice &device) {
+        while (!device.atEnd()) {
+            const auto prefix = co_await qCoro(device).read(4);
+            const auto frame = co_await qCoro(device).read(qFromBigEndian<quint32>(prefix.constData()));
+            Q_UNUSED(frame);
+        }
+    }
+
+private Q_SLOTS:
+    addTest(RoundTrip)
+    addTest(LengthPrefixEncoding)
+    addTest(FramesAcrossReads)
+    addTest(FrameTooLarge)
+    addTest(FrameTooLargeForPrefix)
+    addTest(MalformedVarint)
+    addTest(TruncatedFrame)
+    addTest(TruncatedFrameOfFinishedDevice)
+    addTest(SendFrameBatches)
+    addTest(FlushesOnDestruction)
+    addTest(LargeFrameNotBatched)
+
+    void benchmarkReadFrames_data() {
+        QTest::addColumn<bool>("useFrames");
+        QTest::newRow("frames") << true;
+        QTest::newRow("read") << false;
+    }
+
+    void benchmarkReadFrames() {
+        QFETCH(bool, useFrames);
+        QByteArray data;
+        {
+            QBuffer output(&data);
+            output.open(QIODevice::WriteOnly);
+            FramedStream writer(&output);
+            for (int i = 0; i < 100'000; ++i) {
+                writer.sendFrame(QByteArray(64, 'x'));
+            }
+            writer.flush();
+        }
+        QBuffer input(&data);
+        input.open(QIODevice::ReadOnly);
+
+        QBENCHMARK {
+            input.seek(0);
+            auto task = useFrames ? readFrames(input) : readFramesWithRead(input);
+            QVERIFY(task.isReady());
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(QCoroFramedStreamTest)
+
+#include "qcoroframedstream.moc"
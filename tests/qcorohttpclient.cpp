@@ -0,0 +1,235 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcoro/network/qcorohttpclient.h"
+
+#include <QHash>
+#include <QNetworkRequest>
+#include <QPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include <algorithm>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+//! HTTP server counting the requests, running in the test's event loop.
+/*!
+ * Every request is answered after `responseDelay` with a body that contains the requested
+ * path and a sequence number, so that responses to different requests can be told apart.
+ * The first `failures[path]` requests for the path are answered with 503.
+ */
+class CountingHttpServer : public QObject {
+    Q_OBJECT
+public:
+    CountingHttpServer() {
+        connect(&mServer, &QTcpServer::newConnection, this, [this]() {
+            while (auto *socket = mServer.nextPendingConnection()) {
+                connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { handleData(socket); });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+        mServer.listen(QHostAddress::LocalHost);
+    }
+
+    QNetworkRequest request(const QString &path) const {
+        return QNetworkRequest{QUrl{QStringLiteral("http://127.0.0.1:%1/%2").arg(mServer.serverPort()).arg(path)}};
+    }
+
+    QHash<QByteArray, int> requests;
+    QHash<QByteArray, int> failures;
+    int inFlight = 0;
+    int maxInFlight = 0;
+    std::chrono::milliseconds responseDelay = 50ms;
+
+private:
+    void handleData(QTcpSocket *socket) {
+        auto &buffer = mBuffers[socket];
+        buffer += socket->readAll();
+        const auto headersEnd = buffer.indexOf("\r\n\r\n");
+        if (headersEnd < 0) {
+            return;
+        }
+
+        qsizetype contentLength = 0;
+        const auto headers = buffer.left(headersEnd).split('\n');
+        for (const auto &header : headers) {
+            if (header.toLower().startsWith("content-length:")) {
+                contentLength = header.mid(header.indexOf(':') + 1).trimmed().toLongLong();
+            }
+        }
+        if (buffer.size() < headersEnd + 4 + contentLength) {
+            return;
+        }
+
+        const auto path = headers.first().split(' ').value(1).mid(1);
+        mBuffers.remove(socket);
+        const int number = ++requests[path];
+        maxInFlight = std::max(maxInFlight, ++inFlight);
+
+        QTimer::singleShot(responseDelay, this, [this, socket = QPointer<QTcpSocket>(socket), path, number]() {
+            --inFlight;
+            if (!socket) {
+                return;
+            }
+            QByteArray response;
+            if (failures.value(path) >= number) {
+                response = "HTTP/1.1 503 Service Unavailable\r\n"
+                           "Content-Length: 0\r\n"
+                           "Connection: close\r\n"
+                           "\r\n";
+            } else {
+                const QByteArray body = path + ' ' + QByteArray::number(number);
+                response = "HTTP/1.1 200 OK\r\n"
+                           "Content-Type: text/plain\r\n"
+                           "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+                           "Connection: close\r\n"
+                           "\r\n" + body;
+            }
+            socket->write(response);
+            socket->disconnectFromHost();
+        });
+    }
+
+    QTcpServer mServer;
+    QHash<QTcpSocket *, QByteArray> mBuffers;
+};
+
+class QCoroHttpClientTest : public QCoro::TestObject<QCoroHttpClientTest> {
+    Q_OBJECT
+
+private:
+    QCoro::HttpClient::RetryPolicy fastRetryPolicy(int maxRetries) const {
+        QCoro::HttpClient::RetryPolicy policy;
+        policy.maxRetries = maxRetries;
+        policy.initialDelay = 10ms;
+        policy.maxDelay = 50ms;
+        return policy;
+    }
+
+    QCoro::Task<> testGet_coro(QCoro::TestContext) {
+        CountingHttpServer server;
+        QCoro::HttpClient client;
+
+        const auto response = co_await client.get(server.request(QStringLiteral("get")));
+        QCORO_VERIFY(response.isSuccess());
+        QCORO_COMPARE(response.statusCode, 200);
+        QCORO_COMPARE(response.body, QByteArray("get 1"));
+        QCORO_COMPARE(response.header("content-type"), QByteArray("text/plain"));
+        QCORO_COMPARE(response.attempts, 1);
+    }
+
+    QCoro::Task<> testCoalescesIdenticalGets_coro(QCoro::TestContext) {
+        CountingHttpServer server;
+        QCoro::HttpClient client;
+
+        std::vector<QCoro::Task<QCoro::HttpClient::Response>> tasks;
+        for (int i = 0; i < 10; ++i) {
+            tasks.push_back(client.get(server.request(QStringLiteral("shared"))));
+        }
+        const auto responses = co_await QCoro::whenAll(std::move(tasks));
+
+        QCORO_COMPARE(server.requests.value("shared"), 1);
+        for (const auto &response : responses) {
+            QCORO_VERIFY(response.isSuccess());
+            QCORO_COMPARE(response.body, QByteArray("shared 1"));
+        }
+
+        // Once the request has finished, an identical one is sent again
+        const auto response = co_await client.get(server.request(QStringLiteral("shared")));
+        QCORO_COMPARE(response.body, QByteArray("shared 2"));
+    }
+
+    QCoro::Task<> testDoesntCoalesceDifferentHeaders_coro(QCoro::TestContext) {
+        CountingHttpServer server;
+        QCoro::HttpClient client;
+
+        auto english = server.request(QStringLiteral("page"));
+        english.setRawHeader("Accept-Language", "en");
+        auto czech = server.request(QStringLiteral("page"));
+        czech.setRawHeader("Accept-Language", "cs");
+
+        const auto [first, second] = co_await QCoro::whenAll(client.get(english), client.get(czech));
+        QCORO_VERIFY(first.isSuccess());
+        QCORO_VERIFY(second.isSuccess());
+        QCORO_COMPARE(server.requests.value("page"), 2);
+        QCORO_VERIFY(first.body != second.body);
+    }
+
+    QCoro::Task<> testLimitsRequestsPerHost_coro(QCoro::TestContext) {
+        CountingHttpServer server;
+        QCoro::HttpClient client;
+        client.setMaxRequestsPerHost(2);
+
+        std::vector<QCoro::Task<QCoro::HttpClient::Response>> tasks;
+        for (int i = 0; i < 6; ++i) {
+            tasks.push_back(client.get(server.request(QStringLiteral("path%1").arg(i))));
+        }
+        const auto responses = co_await QCoro::whenAll(std::move(tasks));
+
+        for (const auto &response : responses) {
+            QCORO_VERIFY(response.isSuccess());
+        }
+        // The limit holds, yet the requests still run concurrently up to it
+        QCORO_COMPARE(server.maxInFlight, 2);
+    }
+
+    QCoro::Task<> testRetriesTransientFailure_coro(QCoro::TestContext) {
+        CountingHttpServer server;
+        server.failures.insert("flaky", 2);
+        QCoro::HttpClient client;
+        client.setRetryPolicy(fastRetryPolicy(3));
+
+        const auto response = co_await client.get(server.request(QStringLiteral("flaky")));
+        QCORO_VERIFY(response.isSuccess());
+        QCORO_COMPARE(response.body, QByteArray("flaky 3"));
+        QCORO_COMPARE(response.attempts, 3);
+        QCORO_COMPARE(server.requests.value("flaky"), 3);
+    }
+
+    QCoro::Task<> testGivesUpAfterMaxRetries_coro(QCoro::TestContext) {
+        CountingHttpServer server;
+        server.failures.insert("broken", 10);
+        QCoro::HttpClient client;
+        client.setRetryPolicy(fastRetryPolicy(2));
+
+        const auto response = co_await client.get(server.request(QStringLiteral("broken")));
+        QCORO_VERIFY(!response.isSuccess());
+        QCORO_COMPARE(response.statusCode, 503);
+        QCORO_COMPARE(response.attempts, 3);
+        QCORO_COMPARE(server.requests.value("broken"), 3);
+    }
+
+    QCoro::Task<> testDoesntRetryPost_coro(QCoro::TestContext) {
+        CountingHttpServer server;
+        server.failures.insert("submit", 1);
+        QCoro::HttpClient client;
+        client.setRetryPolicy(fastRetryPolicy(3));
+
+        auto request = server.request(QStringLiteral("submit"));
+        request.setHeader(QNetworkRequest::ContentTypeHeader, QByteArray("text/plain"));
+        const auto response = co_await client.post(request, "data");
+        QCORO_VERIFY(!response.isSuccess());
+        QCORO_COMPARE(response.statusCode, 503);
+        QCORO_COMPARE(response.attempts, 1);
+        QCORO_COMPARE(server.requests.value("submit"), 1);
+    }
+
+private Q_SLOTS:
+    addTest(Get)
+    addTest(CoalescesIdenticalGets)
+    addTest(DoesntCoalesceDifferentHeaders)
+    addTest(LimitsRequestsPerHost)
+    addTest(RetriesTransientFailure)
+    addTest(GivesUpAfterMaxRetries)
+    addTest(DoesntRetryPost)
+};
+
+QTEST_GUILESS_MAIN(QCoroHttpClientTest)
+
+#include "qcorohttpclient.moc"
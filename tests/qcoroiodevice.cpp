@@ -0,0 +1,498 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+#include "pipedevice.h"
+
+#include "qcoro/core/qcoroiodevice.h"
+#include "qcoro/core/qcoroprocess.h"
+
+#include <QBuffer>
+#include <QList>
+#include <QProcess>
+#include <QTemporaryFile>
+#include <QTimer>
+
+#include <algorithm>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+//! Sequential device that drains the written data over time, like a socket to a slow peer.
+class SlowSinkDevice : public QIODevice {
+    Q_OBJECT
+public:
+    explicit SlowSinkDevice(qint64 drainSize)
+        : mDrainSize(drainSize)
+    {
+        open(QIODevice::WriteOnly);
+        connect(&mDrainTimer, &QTimer::timeout, this, &SlowSinkDevice::drain);
+        mDrainTimer.start(1ms);
+    }
+
+    bool isSequential() const override {
+        return true;
+    }
+
+    qint64 bytesToWrite() const override {
+        return mPending.size();
+    }
+
+    //! Data that have been drained from the device.
+    QByteArray drained;
+    //! The most data that have ever been pending in the device.
+    qint64 maxPending = 0;
+
+protected:
+    qint64 readData(char *, qint64) override {
+        return -1;
+    }
+
+    qint64 writeData(const char *data, qint64 size) override {
+        mPending.append(data, size);
+        maxPending = std::max<qint64>(maxPending, mPending.size());
+        return size;
+    }
+
+private:
+    void drain() {
+        if (mPending.isEmpty()) {
+            return;
+        }
+        const auto size = std::min<qint64>(mDrainSize, mPending.size());
+        drained += mPending.left(size);
+        mPending.remove(0, size);
+        Q_EMIT bytesWritten(size);
+    }
+
+    QTimer mDrainTimer;
+    qint64 mDrainSize;
+    QByteArray mPending;
+};
+
+class QCoroIODeviceTest : public QCoro::TestObject<QCoroIODeviceTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testChunksFromBuffer_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        QByteArray content(10'000, 'a');
+        QBuffer buffer(&content);
+        buffer.open(QIODevice::ReadOnly);
+
+        QByteArray data;
+        std::vector<qsizetype> sizes;
+        QCORO_FOREACH(const QByteArray &chunk, qCoro(buffer).chunks(4096)) {
+            sizes.push_back(chunk.size());
+            data += chunk;
+        }
+        QCORO_COMPARE(sizes, (std::vector<qsizetype>{4096, 4096, 1808}));
+        QCORO_COMPARE(data, content);
+    }
+
+    QCoro::Task<> testChunksFromSequentialDevice_coro(QCoro::TestContext) {
+        PipeDevice device;
+        QTimer::singleShot(10ms, &device, [&device]() { device.feed("Hello "); });
+        QTimer::singleShot(20ms, &device, [&device]() { device.feed("World!"); });
+        QTimer::singleShot(30ms, &device, [&device]() {
+            device.feed("Bye!");
+            device.finish();
+        });
+
+        QByteArray data;
+        QCORO_FOREACH(const QByteArray &chunk, qCoro(device).chunks(4)) {
+            QCORO_VERIFY(chunk.size() <= 4);
+            data += chunk;
+        }
+        QCORO_COMPARE(data, QByteArray("Hello World!Bye!"));
+    }
+
+    QCoro::Task<> testChunksTimeout_coro(QCoro::TestContext) {
+        PipeDevice device;
+        QTimer::singleShot(10ms, &device, [&device]() { device.feed("Hello"); });
+
+        QByteArray data;
+        QCORO_FOREACH(const QByteArray &chunk, qCoro(device).chunks(1024, 100ms)) {
+            data += chunk;
+        }
+        QCORO_COMPARE(data, QByteArray("Hello"));
+    }
+
+    QCoro::Task<> testChunksEndOnClose_coro(QCoro::TestContext) {
+        PipeDevice device;
+        QTimer::singleShot(10ms, &device, [&device]() { device.close(); });
+
+        int chunks = 0;
+        QCORO_FOREACH(const QByteArray &chunk, qCoro(device).chunks(1024)) {
+            Q_UNUSED(chunk);
+            ++chunks;
+        }
+        QCORO_COMPARE(chunks, 0);
+    }
+
+    QCoro::Task<> testChunksReuseBuffers_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        QByteArray content(1024, 'a');
+        content += QByteArray(1024, 'b');
+        content += QByteArray(1024, 'c');
+        QBuffer buffer(&content);
+        buffer.open(QIODevice::ReadOnly);
+
+        auto generator = qCoro(buffer).chunks(1024);
+        auto it = co_await generator.begin();
+        const auto *firstData = (*it).constData();
+        co_await ++it;
+        // The consumer didn't keep the first chunk, so its buffer is reused
+        QCORO_COMPARE((*it).constData(), firstData);
+        const QByteArray kept = *it;
+        co_await ++it;
+        // The second chunk is still held by the consumer and must not be overwritten
+        QCORO_VERIFY((*it).constData() != kept.constData());
+        QCORO_COMPARE(kept, QByteArray(1024, 'b'));
+        QCORO_COMPARE(*it, QByteArray(1024, 'c'));
+    }
+
+    QCoro::Task<> testReadExactly_coro(QCoro::TestContext) {
+        PipeDevice device;
+        QTimer::singleShot(10ms, &device, [&device]() { device.feed("He"); });
+        QTimer::singleShot(20ms, &device, [&device]() { device.feed("llo W"); });
+        QTimer::singleShot(30ms, &device, [&device]() { device.feed("orld"); });
+
+        QCORO_COMPARE(co_await qCoro(device).readExactly(5), QByteArray("Hello"));
+        QCORO_COMPARE(co_await qCoro(device).readExactly(6), QByteArray(" World"));
+    }
+
+    QCoro::Task<> testReadExactlyEnd_coro(QCoro::TestContext) {
+        PipeDevice device;
+        QTimer::singleShot(10ms, &device, [&device]() {
+            device.feed("abc");
+            device.finish();
+        });
+
+        QCORO_COMPARE(co_await qCoro(device).readExactly(5), QByteArray("abc"));
+    }
+
+    QCoro::Task<> testReadUntil_coro(QCoro::TestContext) {
+        PipeDevice device;
+        // The delimiter is split between the writes
+        QTimer::singleShot(10ms, &device, [&device]() { device.feed("GET / HTTP/1.1\r\nHost: "); });
+        QTimer::singleShot(20ms, &device, [&device]() { device.feed("localhost\r\n\r"); });
+        QTimer::singleShot(30ms, &device, [&device]() { device.feed("\nbody"); });
+
+        const auto headers = co_await qCoro(device).readUntil("\r\n\r\n");
+        QCORO_COMPARE(headers, QByteArray("GET / HTTP/1.1\r\nHost: localhost\r\n\r\n"));
+        // Nothing past the delimiter has been consumed
+        QCORO_COMPARE(device.readAll(), QByteArray("body"));
+    }
+
+    QCoro::Task<> testReadUntilMaxSize_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        QByteArray content("aaaaaaaa\n");
+        QBuffer buffer(&content);
+        buffer.open(QIODevice::ReadOnly);
+
+        QCORO_COMPARE(co_await qCoro(buffer).readUntil("\n", 4), QByteArray("aaaa"));
+        QCORO_COMPARE(co_await qCoro(buffer).readUntil("\n", 4), QByteArray("aaaa"));
+        QCORO_COMPARE(co_await qCoro(buffer).readUntil("\n", 4), QByteArray("\n"));
+    }
+
+    QCoro::Task<> testReadUntilTimeout_coro(QCoro::TestContext) {
+        PipeDevice device;
+        QTimer::singleShot(10ms, &device, [&device]() { device.feed("no delimiter"); });
+
+        QCORO_COMPARE(co_await qCoro(device).readUntil(";", 0, 100ms), QByteArray("no delimiter"));
+    }
+
+    QCoro::Task<> testLines_coro(QCoro::TestContext) {
+        PipeDevice device;
+        QTimer::singleShot(10ms, &device, [&device]() { device.feed("one\ntw"); });
+        QTimer::singleShot(20ms, &device, [&device]() { device.feed("o\nthree\n"); });
+        QTimer::singleShot(30ms, &device, [&device]() {
+            device.feed("four");
+            device.finish();
+        });
+
+        QList<QByteArray> lines;
+        QCORO_FOREACH(const QByteArray &line, qCoro(device).lines()) {
+            lines.push_back(line);
+        }
+        QCORO_COMPARE(lines, (QList<QByteArray>{"one\n", "two\n", "three\n", "four"}));
+    }
+
+    QCoro::Task<> testLinesMaxLineSize_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        QByteArray content("abcdef\ngh\n");
+        QBuffer buffer(&content);
+        buffer.open(QIODevice::ReadOnly);
+
+        QList<QByteArray> lines;
+        QCORO_FOREACH(const QByteArray &line, qCoro(buffer).lines(4)) {
+            lines.push_back(line);
+        }
+        QCORO_COMPARE(lines, (QList<QByteArray>{"abcd", "ef\n", "gh\n"}));
+    }
+
+    QCoro::Task<> testReader_coro(QCoro::TestContext) {
+        PipeDevice device;
+        QTimer::singleShot(10ms, &device, [&device]() { device.feed("Hello "); });
+        QTimer::singleShot(20ms, &device, [&device]() { device.feed("World!\nBye!"); });
+        QTimer::singleShot(30ms, &device, [&device]() { device.finish(); });
+
+        auto reader = qCoro(device).reader();
+        QCORO_COMPARE(co_await reader.read(4), QByteArray("Hell"));
+        QCORO_COMPARE(co_await reader.readAll(), QByteArray("o "));
+        QCORO_COMPARE(co_await reader.readLine(), QByteArray("World!\n"));
+        QCORO_COMPARE(co_await reader.readAll(), QByteArray("Bye!"));
+        QCORO_VERIFY(!reader.atEnd());
+        QCORO_VERIFY(!co_await reader.waitForReadyRead());
+        QCORO_VERIFY(reader.atEnd());
+        QCORO_COMPARE(co_await reader.read(4), QByteArray());
+    }
+
+    QCoro::Task<> testReaderDoesntSuspendWithData_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        QByteArray content("Hello World!");
+        QBuffer buffer(&content);
+        buffer.open(QIODevice::ReadOnly);
+
+        auto reader = qCoro(buffer).reader();
+        QCORO_COMPARE(co_await reader.read(6), QByteArray("Hello "));
+        QCORO_COMPARE(co_await reader.readAll(), QByteArray("World!"));
+        QCORO_VERIFY(reader.atEnd());
+        QCORO_COMPARE(co_await reader.readAll(), QByteArray());
+    }
+
+    QCoro::Task<> testReaderTimeout_coro(QCoro::TestContext) {
+        PipeDevice device;
+        QTimer::singleShot(10ms, &device, [&device]() { device.feed("Hello"); });
+
+        auto reader = qCoro(device).reader();
+        QCORO_COMPARE(co_await reader.readAll(100ms), QByteArray("Hello"));
+        QCORO_VERIFY(!co_await reader.waitForReadyRead(100ms));
+        // The reader keeps working after a timeout
+        QTimer::singleShot(10ms, &device, [&device]() { device.feed("World"); });
+        QCORO_COMPARE(co_await reader.readAll(100ms), QByteArray("World"));
+    }
+
+    QCoro::Task<> testReaderEndOnClose_coro(QCoro::TestContext) {
+        PipeDevice device;
+        QTimer::singleShot(10ms, &device, [&device]() { device.close(); });
+
+        auto reader = qCoro(device).reader();
+        QCORO_COMPARE(co_await reader.readAll(), QByteArray());
+        QCORO_VERIFY(reader.atEnd());
+    }
+
+    QCoro::Task<> testWriteAllBuffers_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        QByteArray content;
+        QBuffer buffer(&content);
+        buffer.open(QIODevice::WriteOnly);
+
+        const QByteArray parts[] = {"Hello", " ", "World"};
+        QCORO_COMPARE(co_await qCoro(buffer).writeAll(parts), qint64{11});
+        QCORO_COMPARE(content, QByteArray("Hello World"));
+    }
+
+    QCoro::Task<> testWriteAllToFile_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        QTemporaryFile file;
+        QCORO_VERIFY(file.open());
+
+        // The file keeps the small parts in its write buffer and never emits bytesWritten() for them
+        const QByteArray parts[] = {"Hello", QByteArray(20'000, ' '), "World"};
+        QCORO_COMPARE(co_await qCoro(file).writeAll(parts, 1024), qint64{20'010});
+        QCORO_COMPARE(file.bytesToWrite(), qint64{0});
+        file.seek(0);
+        QCORO_COMPARE(file.readAll(), parts[0] + parts[1] + parts[2]);
+    }
+
+    QCoro::Task<> testWriteAllBackpressure_coro(QCoro::TestContext) {
+        constexpr qint64 highWaterMark = 4096;
+        SlowSinkDevice device(1024);
+        std::vector<QByteArray> buffers;
+        QByteArray expected;
+        for (int i = 0; i < 64; ++i) {
+            buffers.emplace_back(1024, static_cast<char>('a' + i % 26));
+            expected += buffers.back();
+        }
+
+        QCORO_COMPARE(co_await qCoro(device).writeAll(buffers, highWaterMark), qint64{64 * 1024});
+        QCORO_COMPARE(device.bytesToWrite(), qint64{0});
+        QCORO_COMPARE(device.drained, expected);
+        // A buffer is only written while there's less than highWaterMark pending
+        QCORO_VERIFY(device.maxPending < highWaterMark + 1024);
+    }
+
+    QCoro::AsyncGenerator<QByteArray> produce(SlowSinkDevice &device, int count, qint64 &maxPendingOnRequest) {
+        for (int i = 0; i < count; ++i) {
+            maxPendingOnRequest = std::max(maxPendingOnRequest, device.bytesToWrite());
+            co_yield QByteArray(1024, static_cast<char>('a' + i % 26));
+        }
+    }
+
+    QCoro::Task<> testWriteAllFromGenerator_coro(QCoro::TestContext) {
+        constexpr qint64 highWaterMark = 4096;
+        SlowSinkDevice device(1024);
+        qint64 maxPendingOnRequest = 0;
+
+        const auto written = co_await qCoro(device).writeAll(produce(device, 64, maxPendingOnRequest), highWaterMark);
+        QCORO_COMPARE(written, qint64{64 * 1024});
+        QCORO_VERIFY(device.drained.size() == 64 * 1024);
+        // The generator is only asked for more data once the device has room for them
+        QCORO_VERIFY(maxPendingOnRequest < highWaterMark);
+        QCORO_VERIFY(device.maxPending < highWaterMark + 1024);
+    }
+
+    QCoro::Task<> testUploadFrom_coro(QCoro::TestContext) {
+        constexpr qint64 bufferSize = 8192;
+        QByteArray content;
+        for (int i = 0; i < 32; ++i) {
+            content += QByteArray(bufferSize, static_cast<char>('a' + i % 26));
+        }
+        QBuffer source(&content);
+        source.open(QIODevice::ReadOnly);
+        SlowSinkDevice destination(4096);
+
+        const auto result = co_await qCoro(destination).uploadFrom(&source, bufferSize);
+        QCORO_VERIFY(result.complete);
+        QCORO_COMPARE(result.bytesTransferred, qint64{content.size()});
+        QCORO_VERIFY(result.elapsed > 0ns);
+        QCORO_VERIFY(result.bytesPerSecond() > 0);
+        QCORO_COMPARE(destination.drained, content);
+        // The next chunk is only read once less than bufferSize is waiting to be written
+        QCORO_VERIFY(destination.maxPending < 2 * bufferSize);
+    }
+
+    QCoro::Task<> testUploadFromTimeout_coro(QCoro::TestContext) {
+        PipeDevice source;
+        QTimer::singleShot(10ms, &source, [&source]() { source.feed("Hello"); });
+        QByteArray content;
+        QBuffer destination(&content);
+        destination.open(QIODevice::WriteOnly);
+
+        const auto result = co_await qCoro(destination).uploadFrom(&source, 1024, 100ms);
+        // The source has neither finished nor been closed
+        QCORO_VERIFY(!result.complete);
+        QCORO_COMPARE(result.bytesTransferred, qint64{5});
+        QCORO_COMPARE(content, QByteArray("Hello"));
+    }
+
+    QCoro::Task<> testUploadFromFinishedProcess_coro(QCoro::TestContext) {
+        QProcess source;
+#ifdef Q_OS_WIN
+        source.start(QStringLiteral("cmd"), {QStringLiteral("/c"), QStringLiteral("echo Hello")});
+#else
+        source.start(QStringLiteral("echo"), {QStringLiteral("Hello")});
+#endif
+        QCORO_VERIFY(co_await qCoro(source).waitForFinished());
+        QByteArray content;
+        QBuffer destination(&content);
+        destination.open(QIODevice::WriteOnly);
+
+        // The process has exited but is still open, the upload must not wait for the timeout
+        const auto start = std::chrono::steady_clock::now();
+        const auto result = co_await qCoro(destination).uploadFrom(&source, 1024, 3s);
+        QCORO_VERIFY(std::chrono::steady_clock::now() - start < 1s);
+        QCORO_VERIFY(result.complete);
+        QCORO_VERIFY(content.startsWith("Hello"));
+    }
+
+    QCoro::Task<> readAllLines(QIODevice &device) {
+        QCORO_FOREACH(const QByteArray &line, qCoro(device).lines()) {
+            Q_UNUSED(line);
+        }
+    }
+
+    QCoro::Task<> readAllWithReadLine(QIODevice &device) {
+        while (!device.atEnd()) {
+            const auto line = co_await qCoro(device).readLine();
+            Q_UNUSED(line);
+        }
+    }
+
+    QCoro::Task<> readAllChunks(QIODevice &device, qint64 chunkSize) {
+        QCORO_FOREACH(const QByteArray &chunk, qCoro(device).chunks(chunkSize)) {
+            Q_UNUSED(chunk);
+        }
+    }
+
+    QCoro::Task<> readAllWithRead(QIODevice &device, qint64 chunkSize) {
+        while (!device.atEnd()) {
+            const auto chunk = co_await qCoro(device).read(chunkSize);
+            Q_UNUSED(chunk);
+        }
+    }
+
+private Q_SLOTS:
+    addTest(ChunksFromBuffer)
+    addTest(ChunksFromSequentialDevice)
+    addTest(ChunksTimeout)
+    addTest(ChunksEndOnClose)
+    addTest(ChunksReuseBuffers)
+    addTest(ReadExactly)
+    addTest(ReadExactlyEnd)
+    addTest(ReadUntil)
+    addTest(ReadUntilMaxSize)
+    addTest(ReadUntilTimeout)
+    addTest(Lines)
+    addTest(LinesMaxLineSize)
+    addTest(Reader)
+    addTest(ReaderDoesntSuspendWithData)
+    addTest(ReaderTimeout)
+    addTest(ReaderEndOnClose)
+    addTest(WriteAllBuffers)
+    addTest(WriteAllToFile)
+    addTest(WriteAllBackpressure)
+    addTest(WriteAllFromGenerator)
+    addTest(UploadFrom)
+    addTest(UploadFromTimeout)
+    addTest(UploadFromFinishedProcess)
+
+    void benchmarkRead_data() {
+        QTest::addColumn<bool>("useChunks");
+        QTest::newRow("chunks") << true;
+        QTest::newRow("read") << false;
+    }
+
+    void benchmarkRead() {
+        QFETCH(bool, useChunks);
+        constexpr qint64 chunkSize = 64 * 1024;
+        QByteArray content(16 * 1024 * 1024, 'x');
+        QBuffer buffer(&content);
+        buffer.open(QIODevice::ReadOnly);
+
+        QBENCHMARK {
+            buffer.seek(0);
+            auto task = useChunks ? readAllChunks(buffer, chunkSize) : readAllWithRead(buffer, chunkSize);
+            QVERIFY(task.isReady());
+        }
+    }
+
+    void benchmarkReadLines_data() {
+        QTest::addColumn<bool>("useLines");
+        QTest::newRow("lines") << true;
+        QTest::newRow("readLine") << false;
+    }
+
+    void benchmarkReadLines() {
+        QFETCH(bool, useLines);
+        QByteArray content;
+        for (int i = 0; i < 100'000; ++i) {
+            content += QByteArray(63, 'x') + '\n';
+        }
+        QBuffer buffer(&content);
+        buffer.open(QIODevice::ReadOnly);
+
+        QBENCHMARK {
+            buffer.seek(0);
+            auto task = useLines ? readAllLines(buffer) : readAllWithReadLine(buffer);
+            QVERIFY(task.isReady());
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(QCoroIODeviceTest)
+
+#include "qcoroiodevice.moc"
@@ -10,6 +10,35 @@
 
 using namespace std::chrono_literals;
 
+// Clang always performs the tail call when transferring execution from one coroutine to another,
+// GCC only does so when optimizations are enabled and AddressSanitizer is not. Without the tail call
+// each hop in a chain of coroutines still costs a stack frame, so the deep chain tests would overflow
+// the stack.
+#if defined(__clang__) || (defined(__OPTIMIZE__) && !defined(__SANITIZE_ADDRESS__))
+#define QCORO_HAS_GUARANTEED_SYMMETRIC_TRANSFER 1
+#endif
+
+namespace {
+
+constexpr int deepChainDepth = 1'000'000;
+
+QCoro::LazyTask<int> syncChain(int depth) {
+    if (depth == 0) {
+        co_return 0;
+    }
+    co_return 1 + co_await syncChain(depth - 1);
+}
+
+QCoro::LazyTask<int> asyncChain(int depth) {
+    if (depth == 0) {
+        co_await QCoro::sleepFor(1ms);
+        co_return 0;
+    }
+    co_return 1 + co_await asyncChain(depth - 1);
+}
+
+} // namespace
+
 class QCoroLazyTaskTest : public QCoro::TestObject<QCoroLazyTaskTest>
 {
     Q_OBJECT
@@ -167,6 +196,23 @@ private Q_SLOTS:
         const auto result = QCoro::waitFor(coro());
         QCOMPARE(result, 42);
     }
+
+    void testDeepSyncChain() {
+#ifndef QCORO_HAS_GUARANTEED_SYMMETRIC_TRANSFER
+        QSKIP("The compiler doesn't guarantee symmetric transfer in this build configuration");
+#endif
+        const auto result = QCoro::waitFor(syncChain(deepChainDepth));
+        QCOMPARE(result, deepChainDepth);
+    }
+
+    void testDeepAsyncChain() {
+#ifndef QCORO_HAS_GUARANTEED_SYMMETRIC_TRANSFER
+        QSKIP("The compiler doesn't guarantee symmetric transfer in this build configuration");
+#endif
+        // The whole chain is resumed from the event loop once the innermost coroutine wakes up.
+        const auto result = QCoro::waitFor(asyncChain(deepChainDepth));
+        QCOMPARE(result, deepChainDepth);
+    }
 };
 
 
@@ -12,6 +12,7 @@
 #include <QLocalServer>
 #include <QLocalSocket>
 
+#include <memory>
 #include <thread>
 
 static const QByteArray blockRequest = "GET /block HTTP/1.1\r\n";
@@ -330,6 +331,31 @@ private:
         QVERIFY(mServer.waitForConnection());
     }
 
+    QCoro::Task<qint64> readWithReader(QLocalSocket &socket, qint64 size, qint64 chunkSize) {
+        auto reader = qCoro(socket).reader();
+        qint64 total = 0;
+        while (total < size) {
+            const auto data = co_await reader.read(chunkSize);
+            if (data.isEmpty() && reader.atEnd()) {
+                break;
+            }
+            total += data.size();
+        }
+        co_return total;
+    }
+
+    QCoro::Task<qint64> readWithRead(QLocalSocket &socket, qint64 size, qint64 chunkSize) {
+        qint64 total = 0;
+        while (total < size) {
+            const auto data = co_await qCoro(socket).read(chunkSize);
+            if (data.isEmpty() && socket.state() != QLocalSocket::ConnectedState) {
+                break;
+            }
+            total += data.size();
+        }
+        co_return total;
+    }
+
 private Q_SLOTS:
     void init() {
         mServer.start(QCoroLocalSocketTest::getSocketName());
@@ -351,6 +377,54 @@ private Q_SLOTS:
     addCoroAndThenTests(ReadTriggers)
     addCoroAndThenTests(ReadLineTriggers)
 
+    void benchmarkRead_data() {
+        QTest::addColumn<bool>("useReader");
+        QTest::newRow("reader") << true;
+        QTest::newRow("read") << false;
+    }
+
+    // Reads 1 GiB (16 MiB unless QCORO_FULL_BENCHMARKS is set) in small chunks, so that most
+    // of the reads have to wait for more data to arrive
+    void benchmarkRead() {
+        QFETCH(bool, useReader);
+        const qint64 totalSize = benchmarkSize<qint64>(16 * 1024 * 1024, 1024 * 1024 * 1024);
+        constexpr qint64 chunkSize = 4 * 1024;
+
+        const auto name = getSocketName() + QStringLiteral("-benchmark");
+        QLocalServer::removeServer(name);
+        QLocalServer server;
+        QVERIFY(server.listen(name));
+
+        QBENCHMARK_ONCE {
+            std::thread writer([name, totalSize]() {
+                QLocalSocket socket;
+                socket.connectToServer(name);
+                if (!socket.waitForConnected(5000)) {
+                    return;
+                }
+                const QByteArray block(64 * 1024, 'x');
+                for (qint64 written = 0; written < totalSize; written += block.size()) {
+                    socket.write(block);
+                    socket.waitForBytesWritten(-1);
+                }
+                socket.disconnectFromServer();
+                if (socket.state() != QLocalSocket::UnconnectedState) {
+                    socket.waitForDisconnected(-1);
+                }
+            });
+
+            std::unique_ptr<QLocalSocket> socket;
+            if (server.waitForNewConnection(5000)) {
+                socket.reset(server.nextPendingConnection());
+            }
+            const auto total = socket ? QCoro::waitFor(useReader ? readWithReader(*socket, totalSize, chunkSize)
+                                                                 : readWithRead(*socket, totalSize, chunkSize))
+                                      : 0;
+            writer.join();
+            QCOMPARE(total, totalSize);
+        }
+    }
+
 private:
     static QString getSocketName() {
 
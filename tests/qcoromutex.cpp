@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+#include "qcoromutex.h"
+#include "qcorotimer.h"
+#include "qcoro/core/qcorothreadpool.h"
+
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+QCoro::Task<> lockAndRecord(QCoro::Mutex &mutex, std::vector<int> &order, int value) {
+    const auto locker = co_await mutex.scopedLock();
+    order.push_back(value);
+    co_await QCoro::sleepFor(10ms);
+}
+
+QCoro::Task<> incrementOnPool(QCoro::ThreadPool &pool, QCoro::Mutex &mutex, int &counter) {
+    for (int i = 0; i < 100; ++i) {
+        co_await pool.schedule();
+        const auto locker = co_await mutex.scopedLock(pool);
+        const int value = counter;
+        std::this_thread::yield();
+        counter = value + 1;
+    }
+}
+
+} // namespace
+
+class QCoroMutexTest : public QCoro::TestObject<QCoroMutexTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testLockUnlocked_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+
+        QCoro::Mutex mutex;
+        QCORO_VERIFY(!mutex.isLocked());
+        co_await mutex.lock();
+        QCORO_VERIFY(mutex.isLocked());
+        QCORO_VERIFY(!mutex.tryLock());
+        mutex.unlock();
+        QCORO_VERIFY(!mutex.isLocked());
+    }
+
+    QCoro::Task<> testScopedLock_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+
+        QCoro::Mutex mutex;
+        {
+            auto locker = co_await mutex.scopedLock();
+            QCORO_VERIFY(mutex.isLocked());
+            QCORO_COMPARE(locker.mutex(), &mutex);
+            locker.unlock();
+            QCORO_VERIFY(!mutex.isLocked());
+            QCORO_COMPARE(locker.mutex(), nullptr);
+        }
+        {
+            const auto locker = co_await mutex.scopedLock();
+            QCORO_VERIFY(mutex.isLocked());
+        }
+        QCORO_VERIFY(!mutex.isLocked());
+    }
+
+    QCoro::Task<> testFifoOrder_coro(QCoro::TestContext) {
+        QCoro::Mutex mutex;
+        std::vector<int> order;
+        std::vector<QCoro::Task<>> tasks;
+        for (int i = 0; i < 5; ++i) {
+            tasks.push_back(lockAndRecord(mutex, order, i));
+        }
+        // Only the first coroutine got the lock, the others are waiting
+        QCORO_COMPARE(order, std::vector<int>{0});
+
+        co_await QCoro::whenAll(tasks);
+        QCORO_COMPARE(order, (std::vector<int>{0, 1, 2, 3, 4}));
+        QCORO_VERIFY(!mutex.isLocked());
+    }
+
+    QCoro::Task<> testAcrossThreads_coro(QCoro::TestContext) {
+        QCoro::ThreadPool pool(4);
+        auto &origin = QCoro::ThreadExecutor::current();
+        QCoro::Mutex mutex;
+        int counter = 0;
+
+        std::vector<QCoro::Task<>> tasks;
+        for (int i = 0; i < 10; ++i) {
+            tasks.push_back(incrementOnPool(pool, mutex, counter));
+        }
+        co_await QCoro::whenAll(tasks);
+        co_await origin.schedule();
+
+        QCORO_COMPARE(counter, 1000);
+        QCORO_VERIFY(!mutex.isLocked());
+    }
+
+private Q_SLOTS:
+    addTest(LockUnlocked)
+    addTest(ScopedLock)
+    addTest(FifoOrder)
+    addTest(AcrossThreads)
+};
+
+QTEST_GUILESS_MAIN(QCoroMutexTest)
+
+#include "qcoromutex.moc"
@@ -8,9 +8,12 @@
 
 #include "qcoro/network/qcoronetworkreply.h"
 
+#include <QBuffer>
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QTcpServer>
+#include <QTemporaryFile>
+#include <QTimer>
 
 class QCoroNetworkReplyTest : public QCoro::TestObject<QCoroNetworkReplyTest> {
     Q_OBJECT
@@ -167,6 +170,75 @@ private:
         QVERIFY(called);
     }
 
+    QCoro::Task<> testBodyChunks_coro(QCoro::TestContext) {
+        QNetworkAccessManager nam;
+        auto reply = std::unique_ptr<QNetworkReply>(
+            nam.get(buildRequest(QStringLiteral("stream"))));
+
+        QByteArray data;
+        bool receivedBeforeFinished = false;
+        QCORO_FOREACH(const QByteArray &chunk, qCoro(reply.get()).bodyChunks(16)) {
+            QCORO_VERIFY(chunk.size() <= 16);
+            // The server sends the body line by line, so the first chunks arrive long before the end
+            receivedBeforeFinished |= !reply->isFinished();
+            data += chunk;
+        }
+
+        QCORO_COMPARE(reply->readBufferSize(), qint64{16});
+        QCORO_VERIFY(receivedBeforeFinished);
+        QCORO_VERIFY(reply->isFinished());
+        QCORO_COMPARE(reply->error(), QNetworkReply::NoError);
+        QCORO_COMPARE(data.size(), reply->rawHeader("Content-Length").toInt());
+        QCORO_VERIFY(data.startsWith("Hola 0\n"));
+    }
+
+    QCoro::Task<> testBodyChunksOfFinishedReply_coro(QCoro::TestContext context) {
+        QNetworkAccessManager nam;
+        auto reply = std::unique_ptr<QNetworkReply>(nam.get(buildRequest()));
+        co_await reply.get();
+
+        context.setShouldNotSuspend();
+        QByteArray data;
+        QCORO_FOREACH(const QByteArray &chunk, qCoro(reply.get()).bodyChunks()) {
+            data += chunk;
+        }
+        QCORO_COMPARE(data, QByteArray("abcdef"));
+    }
+
+    QCoro::Task<> testDownloadTo_coro(QCoro::TestContext) {
+        QNetworkAccessManager nam;
+        auto reply = std::unique_ptr<QNetworkReply>(
+            nam.get(buildRequest(QStringLiteral("stream"))));
+        QTemporaryFile file;
+        QCORO_VERIFY(file.open());
+
+        const auto result = co_await qCoro(reply.get()).downloadTo(&file, 16);
+
+        QCORO_VERIFY(result.complete);
+        QCORO_COMPARE(result.bytesTransferred, reply->rawHeader("Content-Length").toLongLong());
+        QCORO_VERIFY(result.elapsed > 0ns);
+        QCORO_COMPARE(reply->readBufferSize(), qint64{16});
+        file.seek(0);
+        const auto data = file.readAll();
+        QCORO_COMPARE(data.size(), reply->rawHeader("Content-Length").toInt());
+        QCORO_VERIFY(data.startsWith("Hola 0\n"));
+    }
+
+    QCoro::Task<> testDownloadToIncompleteOnError_coro(QCoro::TestContext) {
+        auto request = buildRequest(QStringLiteral("block"));
+        request.setTransferTimeout(300);
+        QNetworkAccessManager nam;
+        auto reply = std::unique_ptr<QNetworkReply>(nam.get(request));
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+
+        const auto result = co_await qCoro(reply.get()).downloadTo(&buffer);
+
+        QCORO_VERIFY(!result.complete);
+        QCORO_COMPARE(reply->error(), QNetworkReply::OperationCanceledError);
+    }
+
     // See https://github.com/danvratil/qcoro/issues/231
     QCoro::Task<> testAbortOnTimeout_coro(QCoro::TestContext) {
         auto request = buildRequest(QStringLiteral("block"));
@@ -180,6 +252,20 @@ private:
         // crash (or cause invalid memory access)
     }
 
+    QCoro::Task<> testAbortOnCancellation_coro(QCoro::TestContext) {
+        QNetworkAccessManager nam;
+        auto *reply = nam.get(buildRequest(QStringLiteral("block")));
+
+        QCoro::CancellationSource source;
+        QTimer::singleShot(100ms, [&source]() { source.requestCancellation(); });
+        const bool finished = co_await qCoro(reply).waitForFinished(source.token());
+
+        QCORO_VERIFY(!finished);
+        QCORO_VERIFY(reply->isFinished());
+        QCORO_COMPARE(reply->error(), QNetworkReply::OperationCanceledError);
+        delete reply;
+    }
+
 private Q_SLOTS:
     void init() {
         mServer.start(QHostAddress::LocalHost);
@@ -197,7 +283,12 @@ private Q_SLOTS:
     addCoroAndThenTests(ReadAllTriggers)
     addCoroAndThenTests(ReadTriggers)
     addCoroAndThenTests(ReadLineTriggers)
+    addTest(BodyChunks)
+    addTest(BodyChunksOfFinishedReply)
+    addTest(DownloadTo)
+    addTest(DownloadToIncompleteOnError)
     addTest(AbortOnTimeout)
+    addTest(AbortOnCancellation)
 
 private:
     QNetworkRequest buildRequest(const QString &path = QString()) {
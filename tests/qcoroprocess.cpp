@@ -7,6 +7,7 @@
 #include "qcoro/core/qcoroprocess.h"
 
 #include <QProcess>
+#include <QTimer>
 
 #ifdef Q_OS_WIN
 // There's no equivalent to "true" command on Windows, so do a single ping to localhost instead,
@@ -216,6 +217,33 @@ private:
         process.waitForFinished();
     }
 
+    QCoro::Task<> testFinishCancelled_coro(QCoro::TestContext) {
+        QProcess process;
+        process.start(SLEEP_EXEC, SLEEP_ARGS(10));
+        process.waitForStarted();
+
+        QCORO_COMPARE(process.state(), QProcess::Running);
+
+        QCoro::CancellationSource source;
+        QTimer::singleShot(100ms, [&source]() { source.requestCancellation(); });
+        const auto ok = co_await qCoro(process).waitForFinished(source.token(), 30s);
+
+        QCORO_VERIFY(!ok);
+        // The process gets killed on cancellation
+        process.waitForFinished(5000);
+        QCORO_COMPARE(process.state(), QProcess::NotRunning);
+    }
+
+    QCoro::Task<> testFinishNotCancelled_coro(QCoro::TestContext) {
+        QProcess process;
+        process.start(DUMMY_EXEC, DUMMY_ARGS);
+        process.waitForStarted();
+
+        QCoro::CancellationSource source;
+        const auto ok = co_await qCoro(process).waitForFinished(source.token());
+        QCORO_VERIFY(ok);
+    }
+
 private Q_SLOTS:
     addCoroAndThenTests(StartTriggers)
     addCoroAndThenTests(StartNoArgsTriggers)
@@ -226,6 +254,8 @@ private Q_SLOTS:
     addCoroAndThenTests(FinishTriggers)
     addTest(FinishDoesntCoAwaitFinishedProcess)
     addCoroAndThenTests(FinishCoAwaitTimeout)
+    addTest(FinishCancelled)
+    addTest(FinishNotCancelled)
 };
 
 QTEST_GUILESS_MAIN(QCoroProcessTest)
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+#include "qcorosemaphore.h"
+#include "qcorotimer.h"
+
+#include <QTimer>
+
+#include <algorithm>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+QCoro::Task<> limitedOperation(QCoro::Semaphore &semaphore, int &running, int &maxRunning) {
+    const auto permit = co_await semaphore.scopedAcquire();
+    ++running;
+    maxRunning = std::max(maxRunning, running);
+    co_await QCoro::sleepFor(10ms);
+    --running;
+}
+
+} // namespace
+
+class QCoroSemaphoreTest : public QCoro::TestObject<QCoroSemaphoreTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testAcquireAvailable_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+
+        QCoro::Semaphore semaphore(2);
+        co_await semaphore.acquire();
+        QCORO_COMPARE(semaphore.available(), std::size_t{1});
+        QCORO_VERIFY(semaphore.tryAcquire());
+        QCORO_COMPARE(semaphore.available(), std::size_t{0});
+        QCORO_VERIFY(!semaphore.tryAcquire());
+
+        semaphore.release(2);
+        QCORO_COMPARE(semaphore.available(), std::size_t{2});
+    }
+
+    QCoro::Task<> testScopedAcquire_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+
+        QCoro::Semaphore semaphore(1);
+        {
+            const auto permit = co_await semaphore.scopedAcquire();
+            QCORO_COMPARE(permit.semaphore(), &semaphore);
+            QCORO_COMPARE(semaphore.available(), std::size_t{0});
+        }
+        QCORO_COMPARE(semaphore.available(), std::size_t{1});
+    }
+
+    QCoro::Task<> testLimitsConcurrency_coro(QCoro::TestContext) {
+        QCoro::Semaphore semaphore(3);
+        int running = 0;
+        int maxRunning = 0;
+
+        std::vector<QCoro::Task<>> tasks;
+        for (int i = 0; i < 20; ++i) {
+            tasks.push_back(limitedOperation(semaphore, running, maxRunning));
+        }
+        QCORO_COMPARE(running, 3);
+
+        co_await QCoro::whenAll(tasks);
+        QCORO_COMPARE(maxRunning, 3);
+        QCORO_COMPARE(running, 0);
+        QCORO_COMPARE(semaphore.available(), std::size_t{3});
+    }
+
+    QCoro::Task<> testReleaseWakesWaiters_coro(QCoro::TestContext) {
+        QCoro::Semaphore semaphore(0);
+        int acquired = 0;
+        const auto waiter = [&]() -> QCoro::Task<> {
+            co_await semaphore.acquire();
+            ++acquired;
+        };
+        auto first = waiter();
+        auto second = waiter();
+        auto third = waiter();
+
+        QTimer::singleShot(10ms, [&semaphore]() { semaphore.release(2); });
+        co_await QCoro::whenAll(first, second);
+        QCORO_COMPARE(acquired, 2);
+        QCORO_VERIFY(!third.isReady());
+
+        semaphore.release();
+        co_await third;
+        QCORO_COMPARE(acquired, 3);
+        QCORO_COMPARE(semaphore.available(), std::size_t{0});
+    }
+
+private Q_SLOTS:
+    addTest(AcquireAvailable)
+    addTest(ScopedAcquire)
+    addTest(LimitsConcurrency)
+    addTest(ReleaseWakesWaiters)
+};
+
+QTEST_GUILESS_MAIN(QCoroSemaphoreTest)
+
+#include "qcorosemaphore.moc"
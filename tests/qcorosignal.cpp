@@ -7,9 +7,13 @@
 #include "qcoro/core/qcorotimer.h"
 #include "qcoro/core/qcorosignal.h"
 
+#include <QElapsedTimer>
 #include <QTimer>
 #include <QThread>
 
+#include <atomic>
+#include <vector>
+
 using namespace std::chrono_literals;
 
 class SignalTest : public QObject {
@@ -125,6 +129,49 @@ private:
         QCORO_VERIFY(result.has_value());
     }
 
+    QCoro::Task<> testCancellationVoid_coro(QCoro::TestContext) {
+        SignalTest obj;
+        QCoro::CancellationSource source;
+        QTimer::singleShot(10ms, [&source]() { source.requestCancellation(); });
+
+        const auto result = co_await qCoro(&obj, &SignalTest::voidSignal, source.token(), 5s);
+        static_assert(std::is_same_v<decltype(result), const std::optional<std::tuple<>>>);
+        QCORO_VERIFY(!result.has_value());
+    }
+
+    QCoro::Task<> testCancellationNotRequested_coro(QCoro::TestContext) {
+        SignalTest obj;
+        QCoro::CancellationSource source;
+
+        const auto result = co_await qCoro(&obj, &SignalTest::singleArg, source.token());
+        QCORO_VERIFY(result.has_value());
+        QCORO_COMPARE(*result, QStringLiteral("YAY!"));
+    }
+
+    QCoro::Task<> testCancellationAlreadyRequested_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+        SignalTest obj;
+        QCoro::CancellationSource source;
+        source.requestCancellation();
+
+        const auto result = co_await qCoro(&obj, &SignalTest::voidSignal, source.token());
+        QCORO_VERIFY(!result.has_value());
+    }
+
+    QCoro::Task<> testCancellationFromDifferentThread_coro(QCoro::TestContext) {
+        SignalTest obj;
+        QCoro::CancellationSource source;
+        std::unique_ptr<QThread> thread(QThread::create([source]() mutable {
+            QThread::msleep(10);
+            source.requestCancellation();
+        }));
+        thread->start();
+
+        const auto result = co_await qCoro(&obj, &SignalTest::voidSignal, source.token());
+        QCORO_VERIFY(!result.has_value());
+        thread->wait();
+    }
+
     QCoro::Task<> testTimeoutTriggersValue_coro(QCoro::TestContext) {
         SignalTest obj;
 
@@ -397,6 +444,123 @@ private:
         QCORO_COMPARE(count, 10);
     }
 
+    QCoro::Task<> testSignalBatchListenerCoalesces_coro(QCoro::TestContext) {
+        SimpleSignal simple;
+        auto generator = qCoroSignalBatchListener(&simple, &SimpleSignal::messageReceived);
+        for (int i = 0; i < 100; ++i) {
+            simple.send(i);
+        }
+
+        // The whole burst is delivered as a single batch
+        auto it = co_await generator.begin();
+        QCORO_VERIFY(it != generator.end());
+        static_assert(std::is_same_v<std::remove_cvref_t<decltype(*it)>, std::vector<int>>);
+        QCORO_COMPARE((*it).size(), std::size_t{100});
+        QCORO_COMPARE((*it).front(), 0);
+        QCORO_COMPARE((*it).back(), 99);
+
+        simple.send(100);
+        co_await ++it;
+        QCORO_COMPARE(*it, std::vector<int>{100});
+    }
+
+    QCoro::Task<> testSignalBatchListenerMaxBatchSize_coro(QCoro::TestContext) {
+        SimpleSignal simple;
+        auto generator = qCoroSignalBatchListener(&simple, &SimpleSignal::messageReceived, 30);
+        for (int i = 0; i < 100; ++i) {
+            simple.send(i);
+        }
+
+        std::vector<std::size_t> sizes;
+        int expected = 0;
+        QCORO_FOREACH(const std::vector<int> &batch, generator) {
+            sizes.push_back(batch.size());
+            for (int value : batch) {
+                QCORO_COMPARE(value, expected++);
+            }
+            if (expected == 100) {
+                break;
+            }
+        }
+        QCORO_COMPARE(sizes, (std::vector<std::size_t>{30, 30, 30, 10}));
+    }
+
+    QCoro::Task<> testSignalBatchListenerMaxLatency_coro(QCoro::TestContext) {
+        SimpleSignal simple;
+        auto generator = qCoroSignalBatchListener(&simple, &SimpleSignal::messageReceived, 10, 100ms);
+        QTimer::singleShot(0, &simple, [&simple]() { simple.send(1); });
+        QTimer::singleShot(50ms, &simple, [&simple]() { simple.send(2); });
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+        // The emissions are held back until the first one has waited for the latency
+        auto it = co_await generator.begin();
+        QCORO_VERIFY(elapsed.elapsed() >= 100);
+        QCORO_COMPARE(*it, (std::vector<int>{1, 2}));
+
+        // A full batch is delivered right away
+        for (int i = 0; i < 15; ++i) {
+            simple.send(i);
+        }
+        elapsed.restart();
+        co_await ++it;
+        QCORO_VERIFY(elapsed.elapsed() < 100);
+        QCORO_COMPARE((*it).size(), std::size_t{10});
+
+        // The rest waits for the latency of the oldest emission
+        co_await ++it;
+        QCORO_VERIFY(elapsed.elapsed() >= 90);
+        QCORO_COMPARE(*it, (std::vector<int>{10, 11, 12, 13, 14}));
+    }
+
+    QCoro::Task<> testSignalBatchListenerTimeout_coro(QCoro::TestContext) {
+        SimpleSignal simple;
+        auto generator = qCoroSignalBatchListener(&simple, &SimpleSignal::messageReceived, 10, 0ms, 10ms);
+        simple.send(1);
+        simple.send(2);
+
+        int batches = 0;
+        QCORO_FOREACH(const std::vector<int> &batch, generator) {
+            QCORO_COMPARE(batch, (std::vector<int>{1, 2}));
+            ++batches;
+        }
+        // The generator ends when no signal is emitted within the timeout
+        QCORO_COMPARE(batches, 1);
+    }
+
+    QCoro::Task<> testSignalFromDifferentThreadRacesTimeout_coro(QCoro::TestContext) {
+        SimpleSignal simple;
+        QThread thread;
+        simple.moveToThread(&thread);
+        thread.start();
+        std::atomic<bool> stop{false};
+        QMetaObject::invokeMethod(&simple, [&simple, &stop]() {
+            for (int i = 1; !stop; ++i) {
+                simple.send(i);
+            }
+        });
+
+        const auto awaitMessage = [](SimpleSignal *simple, std::chrono::milliseconds timeout) -> QCoro::Task<int> {
+            const auto result = co_await qCoro(simple, &SimpleSignal::messageReceived, timeout);
+            co_return result.value_or(-1);
+        };
+        // Each await is resumed exactly once, either by the signal or by the timeout
+        for (int round = 0; round < 100; ++round) {
+            std::vector<QCoro::Task<int>> awaiters;
+            for (int i = 0; i < 10; ++i) {
+                awaiters.push_back(awaitMessage(&simple, std::chrono::milliseconds{i % 3}));
+            }
+            const auto results = co_await QCoro::whenAll(awaiters);
+            for (int result : results) {
+                QCORO_VERIFY(result != 0);
+            }
+        }
+
+        stop = true;
+        thread.quit();
+        thread.wait();
+    }
+
     QCoro::Task<> testSignalEmitterOnDifferentThread_coro(QCoro::TestContext) {
         SignalTest test;
         QThread thread;
@@ -425,6 +589,10 @@ private Q_SLOTS:
     addTest(TimeoutTriggersValue)
     addTest(TimeoutTuple)
     addTest(TimeoutTriggersTuple)
+    addTest(CancellationVoid)
+    addTest(CancellationNotRequested)
+    addTest(CancellationAlreadyRequested)
+    addTest(CancellationFromDifferentThread)
     addTest(ThenChained)
     addTest(VoidQPrivateSignal)
     addTest(SingleArgQPrivateSignal)
@@ -441,7 +609,27 @@ private Q_SLOTS:
     addTest(SignalListenerQPrivateSignalVoid)
     addTest(SignalListenerQPrivateSignalValue)
     addTest(SignalListenerQPrivateSignalTuple)
+    addTest(SignalBatchListenerCoalesces)
+    addTest(SignalBatchListenerMaxBatchSize)
+    addTest(SignalBatchListenerMaxLatency)
+    addTest(SignalBatchListenerTimeout)
     addTest(SignalEmitterOnDifferentThread)
+    addTest(SignalFromDifferentThreadRacesTimeout)
+
+    void testSameThreadEmitDefersResume() {
+        SimpleSignal simple;
+        int result = 0;
+        auto task = [](SimpleSignal *simple, int &result) -> QCoro::Task<> {
+            result = co_await qCoro(simple, &SimpleSignal::messageReceived);
+        }(&simple, result);
+
+        simple.send(1);
+        // The result is stored right away, but the coroutine is resumed from the event loop
+        QVERIFY(!task.isReady());
+        simple.send(2);
+        QTRY_VERIFY(task.isReady());
+        QCOMPARE(result, 1);
+    }
 };
 
 QTEST_GUILESS_MAIN(QCoroSignalTest)
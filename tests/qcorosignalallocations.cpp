@@ -0,0 +1,323 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "allocationcounter.h"
+#include "qcoro/core/qcorosignal.h"
+
+#include <QCoreApplication>
+#include <QTest>
+#include <QThread>
+#include <QTimer>
+
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class Emitter : public QObject {
+    Q_OBJECT
+
+Q_SIGNALS:
+    void ping(int value);
+    void payload(const QByteArray &data);
+};
+
+namespace {
+
+constexpr auto noTimeout = std::chrono::milliseconds{-1};
+
+QCoro::Task<> awaitPing(Emitter *emitter, std::chrono::milliseconds timeout, std::optional<int> &result) {
+    result = co_await qCoro(emitter, &Emitter::ping, timeout);
+}
+
+//! Awaits a signal the way QCoroSignal used to, with a QObject receiver and a QTimer per co_await.
+/*!
+ * Serves as a baseline for the allocation and benchmark tests.
+ */
+template<typename Arg>
+class LegacySignalAwaiter {
+public:
+    using Signal = void (Emitter::*)(Arg);
+    using Value = std::remove_cvref_t<Arg>;
+
+    LegacySignalAwaiter(Emitter *emitter, Signal signal, std::chrono::milliseconds timeout)
+        : mEmitter(emitter)
+        , mSignal(signal)
+        , mDummyReceiver(std::make_unique<QObject>())
+    {
+        if (timeout.count() > -1) {
+            mTimeoutTimer = std::make_unique<QTimer>();
+            mTimeoutTimer->setInterval(timeout);
+            mTimeoutTimer->setSingleShot(true);
+        }
+    }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+        if (mTimeoutTimer) {
+            QObject::connect(mTimeoutTimer.get(), &QTimer::timeout, mEmitter,
+                [this, awaitingCoroutine]() {
+                    QObject::disconnect(mConn);
+                    awaitingCoroutine.resume();
+                }, Qt::DirectConnection);
+            mTimeoutTimer->start();
+        }
+        mConn = QObject::connect(mEmitter, mSignal, mDummyReceiver.get(),
+            [this, awaitingCoroutine](const Value &value) {
+                if (mTimeoutTimer) {
+                    mTimeoutTimer->stop();
+                }
+                QObject::disconnect(mConn);
+                mResult = value;
+                awaitingCoroutine.resume();
+            }, Qt::QueuedConnection);
+    }
+
+    std::optional<Value> await_resume() {
+        return std::move(mResult);
+    }
+
+private:
+    Emitter *mEmitter;
+    Signal mSignal;
+    QMetaObject::Connection mConn;
+    std::optional<Value> mResult;
+    std::unique_ptr<QObject> mDummyReceiver;
+    std::unique_ptr<QTimer> mTimeoutTimer;
+};
+
+// Mirrors qCoro(), which wraps the awaiter in a Task as well.
+QCoro::Task<std::optional<int>> legacyQCoro(Emitter *emitter, std::chrono::milliseconds timeout) {
+    auto result = co_await LegacySignalAwaiter<int>(emitter, &Emitter::ping, timeout);
+    co_return result;
+}
+
+QCoro::Task<> awaitPingLegacy(Emitter *emitter, std::chrono::milliseconds timeout, std::optional<int> &result) {
+    result = co_await legacyQCoro(emitter, timeout);
+}
+
+using AwaitFunction = QCoro::Task<> (*)(Emitter *, std::chrono::milliseconds, std::optional<int> &);
+
+//! Awaits the signal once, the signal is emitted right away and delivered by the event loop.
+bool awaitOnce(AwaitFunction await, Emitter &emitter, std::chrono::milliseconds timeout) {
+    std::optional<int> result;
+    auto task = await(&emitter, timeout, result);
+    Q_EMIT emitter.ping(42);
+    QCoreApplication::sendPostedEvents();
+    return task.isReady() && result == 42;
+}
+
+//! Returns the average number of allocations per await.
+double allocationsPerAwait(AwaitFunction await, std::chrono::milliseconds timeout) {
+    constexpr int awaitCount = 100;
+    Emitter emitter;
+    // Warm up the frame pool and the per-thread signal context
+    if (!awaitOnce(await, emitter, timeout)) {
+        return -1;
+    }
+
+    AllocationCounter counter;
+    for (int i = 0; i < awaitCount; ++i) {
+        if (!awaitOnce(await, emitter, timeout)) {
+            return -1;
+        }
+    }
+    return static_cast<double>(counter.allocations()) / awaitCount;
+}
+
+QCoro::Task<> awaitTimeout(Emitter *emitter, std::chrono::milliseconds timeout, std::vector<int> &timedOut) {
+    const auto result = co_await qCoro(emitter, &Emitter::ping, timeout);
+    if (!result.has_value()) {
+        timedOut.push_back(static_cast<int>(timeout.count()));
+    }
+}
+
+//! Consumes \c count emissions one by one, counting how many times the consumer has been resumed.
+QCoro::Task<> consumeEach(Emitter *emitter, int count, int &resumes) {
+    int received = 0;
+    QCORO_FOREACH(int value, qCoroSignalListener(emitter, &Emitter::ping)) {
+        Q_UNUSED(value);
+        ++resumes;
+        if (++received == count) {
+            break;
+        }
+    }
+}
+
+//! Consumes \c count emissions in batches, counting how many times the consumer has been resumed.
+QCoro::Task<> consumeBatches(Emitter *emitter, int count, int &resumes) {
+    std::size_t received = 0;
+    QCORO_FOREACH(const std::vector<int> &batch, qCoroSignalBatchListener(emitter, &Emitter::ping)) {
+        ++resumes;
+        received += batch.size();
+        if (received == static_cast<std::size_t>(count)) {
+            break;
+        }
+    }
+}
+
+QCoro::Task<> awaitPayload(Emitter *emitter, QByteArray &result) {
+    result = co_await qCoro(emitter, &Emitter::payload);
+}
+
+QCoro::Task<> awaitPayloadLegacy(Emitter *emitter, QByteArray &result) {
+    result = *(co_await LegacySignalAwaiter<const QByteArray &>(emitter, &Emitter::payload, noTimeout));
+}
+
+using ConsumeFunction = QCoro::Task<> (*)(Emitter *, int, int &);
+
+//! Emits a burst of \c count signals and waits until the consumer has received all of them.
+int consumeBurst(ConsumeFunction consume, Emitter &emitter, int count) {
+    int resumes = 0;
+    auto task = consume(&emitter, count, resumes);
+    for (int i = 0; i < count; ++i) {
+        Q_EMIT emitter.ping(i);
+    }
+    while (!task.isReady()) {
+        QCoreApplication::processEvents();
+    }
+    return resumes;
+}
+
+} // namespace
+
+class QCoroSignalAllocationsTest : public QObject {
+    Q_OBJECT
+
+private:
+    void compareWithLegacy(std::chrono::milliseconds timeout, double minimumSaved) {
+        const auto allocations = allocationsPerAwait(&awaitPing, timeout);
+        const auto legacyAllocations = allocationsPerAwait(&awaitPingLegacy, timeout);
+        QVERIFY(allocations >= 0);
+        QVERIFY(legacyAllocations >= 0);
+        qInfo("Allocations per await: %.2f, with a QObject and QTimer per await: %.2f",
+              allocations, legacyAllocations);
+        // At least the QObject receiver (and the QTimer), including their private data, are gone.
+        QVERIFY2(legacyAllocations - allocations >= minimumSaved,
+                 qPrintable(QStringLiteral("%1 vs. %2").arg(allocations).arg(legacyAllocations)));
+    }
+
+    void benchmark(AwaitFunction await, std::chrono::milliseconds timeout) {
+        Emitter emitter;
+        QVERIFY(awaitOnce(await, emitter, timeout));
+        QBENCHMARK {
+            awaitOnce(await, emitter, timeout);
+        }
+    }
+
+private Q_SLOTS:
+    void testAwaitAllocatesLess() {
+        compareWithLegacy(noTimeout, 2);
+    }
+
+    void testAwaitWithTimeoutAllocatesLess() {
+        compareWithLegacy(1min, 4);
+    }
+
+    void testTimeoutsShareTimer() {
+        Emitter emitter;
+        std::vector<int> timedOut;
+        auto third = awaitTimeout(&emitter, 60ms, timedOut);
+        auto first = awaitTimeout(&emitter, 20ms, timedOut);
+        auto second = awaitTimeout(&emitter, 40ms, timedOut);
+        QTRY_VERIFY(first.isReady() && second.isReady() && third.isReady());
+        QCOMPARE(timedOut, (std::vector<int>{20, 40, 60}));
+    }
+
+    void testSignalStopsTimeout() {
+        Emitter emitter;
+        std::vector<int> timedOut;
+        auto task = awaitTimeout(&emitter, 20ms, timedOut);
+        Q_EMIT emitter.ping(42);
+        QTRY_VERIFY(task.isReady());
+        QTest::qWait(40);
+        QVERIFY(timedOut.empty());
+    }
+
+    void testBatchListenerCoalescesBurst() {
+        constexpr int burstSize = 1000;
+        Emitter emitter;
+        QCOMPARE(consumeBurst(&consumeEach, emitter, burstSize), burstSize);
+        QCOMPARE(consumeBurst(&consumeBatches, emitter, burstSize), 1);
+    }
+
+    void benchmarkAwait() {
+        benchmark(&awaitPing, noTimeout);
+    }
+
+    void benchmarkAwaitLegacy() {
+        benchmark(&awaitPingLegacy, noTimeout);
+    }
+
+    void benchmarkAwaitWithTimeout() {
+        benchmark(&awaitPing, 1min);
+    }
+
+    void benchmarkAwaitWithTimeoutLegacy() {
+        benchmark(&awaitPingLegacy, 1min);
+    }
+
+    void benchmarkAwaitPayload_data() {
+        QTest::addColumn<bool>("crossThread");
+        QTest::addColumn<bool>("legacy");
+        QTest::newRow("same thread") << false << false;
+        QTest::newRow("same thread, queued") << false << true;
+        QTest::newRow("cross thread") << true << false;
+        QTest::newRow("cross thread, queued") << true << true;
+    }
+
+    void benchmarkAwaitPayload() {
+        QFETCH(bool, crossThread);
+        QFETCH(bool, legacy);
+        const QByteArray payload(1024 * 1024, 'x');
+        Emitter emitter;
+        QThread thread;
+        if (crossThread) {
+            emitter.moveToThread(&thread);
+            thread.start();
+        }
+
+        const auto await = legacy ? &awaitPayloadLegacy : &awaitPayload;
+        QBENCHMARK {
+            QByteArray result;
+            auto task = await(&emitter, result);
+            if (crossThread) {
+                QMetaObject::invokeMethod(&emitter, [&emitter, &payload]() { Q_EMIT emitter.payload(payload); });
+            } else {
+                Q_EMIT emitter.payload(payload);
+            }
+            while (!task.isReady()) {
+                QCoreApplication::processEvents();
+            }
+            QCOMPARE(result.size(), payload.size());
+        }
+
+        thread.quit();
+        thread.wait();
+    }
+
+    void benchmarkListenerBurst_data() {
+        QTest::addColumn<bool>("batched");
+        QTest::newRow("each") << false;
+        QTest::newRow("batched") << true;
+    }
+
+    void benchmarkListenerBurst() {
+        QFETCH(bool, batched);
+        constexpr int burstSize = 10'000;
+        Emitter emitter;
+        QBENCHMARK {
+            consumeBurst(batched ? &consumeBatches : &consumeEach, emitter, burstSize);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(QCoroSignalAllocationsTest)
+
+#include "qcorosignalallocations.moc"
@@ -0,0 +1,250 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "allocationcounter.h"
+#include "qcorolazytask.h"
+#include "qcorotask.h"
+
+#include <QTest>
+#include <QObject>
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Task and LazyTask are just a handle to the coroutine, without a vtable.
+static_assert(!std::is_polymorphic_v<QCoro::Task<int>>);
+static_assert(!std::is_polymorphic_v<QCoro::LazyTask<int>>);
+static_assert(sizeof(QCoro::Task<int>) == sizeof(std::coroutine_handle<>));
+static_assert(sizeof(QCoro::LazyTask<int>) == sizeof(std::coroutine_handle<>));
+
+namespace {
+
+//! Awaitable that suspends the coroutine until it's resumed manually by the test.
+struct ManualResume {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept { *handle = awaitingCoroutine; }
+    void await_resume() const noexcept {}
+
+    // Some compilers copy the awaitable, so the handle must be stored outside of it.
+    std::coroutine_handle<> *handle;
+};
+
+QCoro::Task<int> awaitedCoroutine(std::coroutine_handle<> &gate) {
+    co_await ManualResume{&gate};
+    co_return 42;
+}
+
+QCoro::Task<> awaitingCoroutine(QCoro::Task<int> &task, int &result) {
+    result = co_await task;
+}
+
+QCoro::Task<> orderedAwaitingCoroutine(QCoro::Task<int> &task, std::vector<int> &order, int id) {
+    co_await task;
+    order.push_back(id);
+}
+
+QCoro::Task<int> readyCoroutine(int value) {
+    co_return value;
+}
+
+Q_NEVER_INLINE QCoro::Task<int> returnTaskByValue(QCoro::Task<int> task) {
+    return task;
+}
+
+struct AllocatorStats {
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+};
+
+//! Allocator that counts allocations made through it.
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    explicit CountingAllocator(AllocatorStats &stats) noexcept: stats(&stats) {}
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U> &other) noexcept: stats(other.stats) {}
+
+    T *allocate(std::size_t n) {
+        ++stats->allocations;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T *ptr, std::size_t n) noexcept {
+        ++stats->deallocations;
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    AllocatorStats *stats;
+};
+
+// GCC falsely reports the frame allocated by the templated operator new as being mismatched
+// with the operator delete.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+QCoro::Task<int> allocatorCoroutine(std::allocator_arg_t, const CountingAllocator<int> &, std::coroutine_handle<> &gate) {
+    co_await ManualResume{&gate};
+    co_return 42;
+}
+
+QCoro::LazyTask<int> lazyAllocatorCoroutine(std::allocator_arg_t, const CountingAllocator<int> &) {
+    co_return 42;
+}
+
+struct AllocatorCoroutineOwner {
+    QCoro::Task<int> coroutine(std::allocator_arg_t, const CountingAllocator<int> &) const {
+        co_return value;
+    }
+
+    int value = 42;
+};
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+} // namespace
+
+class QCoroTaskAllocationsTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testSingleAwaiterDoesNotAllocate() {
+        std::coroutine_handle<> gate;
+        int result = 0;
+        const auto run = [&]() {
+            auto awaited = awaitedCoroutine(gate);
+            auto awaiting = awaitingCoroutine(awaited, result);
+            gate.resume();
+            QVERIFY(awaiting.isReady());
+        };
+
+        // Warm up the frame pool
+        run();
+
+        AllocationCounter counter;
+        run();
+
+        QCOMPARE(result, 42);
+        // At most the two coroutine frames are allocated, registering the awaiter and
+        // resuming it when the awaited coroutine finishes must not allocate.
+#ifdef QCORO_NO_FRAME_POOL
+        QCOMPARE(counter.allocations(), std::size_t{2});
+        QCOMPARE(counter.deallocations(), std::size_t{2});
+#else
+        QCOMPARE(counter.allocations(), std::size_t{0});
+        QCOMPARE(counter.deallocations(), std::size_t{0});
+#endif
+    }
+
+    void testFramesAreReusedFromPool() {
+#ifdef QCORO_NO_FRAME_POOL
+        QSKIP("The coroutine frame pool is disabled in this build.");
+#endif
+        std::coroutine_handle<> gate;
+        int result = 0;
+        QCoro::resetFramePoolStatistics();
+        for (int i = 0; i < 10; ++i) {
+            auto awaited = awaitedCoroutine(gate);
+            auto awaiting = awaitingCoroutine(awaited, result);
+            gate.resume();
+        }
+
+        const auto stats = QCoro::framePoolStatistics();
+        QCOMPARE(stats.allocations, std::size_t{20});
+        QCOMPARE(stats.deallocations, std::size_t{20});
+        // Only the very first iteration may need to allocate new frames.
+        QVERIFY(stats.poolHits >= 18);
+        QVERIFY(stats.hitRate() >= 0.9);
+    }
+
+    void testCustomAllocator() {
+        AllocatorStats allocatorStats;
+        CountingAllocator<int> allocator(allocatorStats);
+        std::coroutine_handle<> gate;
+        QCoro::resetFramePoolStatistics();
+        {
+            auto task = allocatorCoroutine(std::allocator_arg, allocator, gate);
+            QCOMPARE(allocatorStats.allocations, std::size_t{1});
+            gate.resume();
+            QVERIFY(task.isReady());
+        }
+        QCOMPARE(allocatorStats.deallocations, std::size_t{1});
+        // Frames allocated by the custom allocator must bypass the pool
+        QCOMPARE(QCoro::framePoolStatistics().allocations, std::size_t{0});
+
+        QCOMPARE(QCoro::waitFor(lazyAllocatorCoroutine(std::allocator_arg, allocator)), 42);
+        QCOMPARE(allocatorStats.allocations, std::size_t{2});
+        QCOMPARE(allocatorStats.deallocations, std::size_t{2});
+
+        const AllocatorCoroutineOwner owner;
+        QCOMPARE(QCoro::waitFor(owner.coroutine(std::allocator_arg, allocator)), 42);
+        QCOMPARE(allocatorStats.allocations, std::size_t{3});
+        QCOMPARE(allocatorStats.deallocations, std::size_t{3});
+    }
+
+    void testMultipleAwaitersResumedInOrder() {
+        std::coroutine_handle<> gate;
+        std::vector<int> order;
+        {
+            auto awaited = awaitedCoroutine(gate);
+            auto first = orderedAwaitingCoroutine(awaited, order, 1);
+            auto second = orderedAwaitingCoroutine(awaited, order, 2);
+            auto third = orderedAwaitingCoroutine(awaited, order, 3);
+            gate.resume();
+            QVERIFY(first.isReady());
+            QVERIFY(second.isReady());
+            QVERIFY(third.isReady());
+        }
+
+        QCOMPARE(order, (std::vector<int>{1, 2, 3}));
+    }
+
+    void benchmarkSingleAwaiter() {
+        std::coroutine_handle<> gate;
+        int result = 0;
+        QBENCHMARK {
+            auto awaited = awaitedCoroutine(gate);
+            auto awaiting = awaitingCoroutine(awaited, result);
+            gate.resume();
+        }
+        QCOMPARE(result, 42);
+    }
+
+    void benchmarkVectorGrowth() {
+        constexpr int taskCount = 1000;
+        std::vector<QCoro::Task<int>> tasks;
+        for (int i = 0; i < taskCount; ++i) {
+            tasks.push_back(readyCoroutine(i));
+        }
+
+        QBENCHMARK {
+            // Moving the tasks into a vector that's repeatedly reallocated while it grows.
+            std::vector<QCoro::Task<int>> grown;
+            for (auto &task : tasks) {
+                grown.push_back(std::move(task));
+            }
+            tasks = std::move(grown);
+        }
+        QCOMPARE(tasks.size(), std::size_t{taskCount});
+    }
+
+    void benchmarkReturnByValue() {
+        auto task = readyCoroutine(42);
+        QBENCHMARK {
+            for (int i = 0; i < 1000; ++i) {
+                task = returnTaskByValue(std::move(task));
+            }
+        }
+        QVERIFY(task.isReady());
+    }
+};
+
+QTEST_GUILESS_MAIN(QCoroTaskAllocationsTest)
+
+#include "qcorotaskallocations.moc"
@@ -10,8 +10,10 @@
 #include <QTcpServer>
 #include <QTcpSocket>
 
-#include <thread>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -118,9 +120,58 @@ private:
         QCORO_VERIFY(ok);
     }
 
+    QCoro::Task<> testConnections_coro(QCoro::TestContext) {
+        QTcpServer server;
+        QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+
+        std::vector<std::unique_ptr<QTcpSocket>> clients;
+        for (int i = 0; i < 3; ++i) {
+            auto &client = clients.emplace_back(std::make_unique<QTcpSocket>());
+            client->connectToHost(QHostAddress::LocalHost, server.serverPort());
+        }
+
+        std::vector<std::unique_ptr<QTcpSocket>> connections;
+        QCORO_FOREACH(QTcpSocket *connection, qCoro(server).connections(10s)) {
+            QCORO_VERIFY(connection != nullptr);
+            connections.emplace_back(connection);
+            if (connections.size() == clients.size()) {
+                break;
+            }
+        }
+        QCORO_COMPARE(connections.size(), clients.size());
+    }
+
+    QCoro::Task<> testConnectionsEndOnTimeout_coro(QCoro::TestContext) {
+        QTcpServer server;
+        QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+
+        int count = 0;
+        QCORO_FOREACH(QTcpSocket *connection, qCoro(server).connections(100ms)) {
+            Q_UNUSED(connection);
+            ++count;
+        }
+        QCORO_COMPARE(count, 0);
+    }
+
+    QCoro::Task<> testConnectionsEndWhenNotListening_coro(QCoro::TestContext testContext) {
+        testContext.setShouldNotSuspend();
+
+        QTcpServer server;
+
+        int count = 0;
+        QCORO_FOREACH(QTcpSocket *connection, qCoro(server).connections()) {
+            Q_UNUSED(connection);
+            ++count;
+        }
+        QCORO_COMPARE(count, 0);
+    }
+
 private Q_SLOTS:
     addCoroAndThenTests(WaitForNewConnectionTriggers)
     addTest(DoesntCoAwaitPendingConnection)
+    addTest(Connections)
+    addTest(ConnectionsEndOnTimeout)
+    addTest(ConnectionsEndWhenNotListening)
 };
 
 QTEST_GUILESS_MAIN(QCoroTcpServerTest)
@@ -8,6 +8,7 @@
 #include "qcoro/core/qcorosignal.h"
 
 #include <QThread>
+#include <QTimer>
 #include <QScopeGuard>
 
 #include <thread>
@@ -65,10 +66,51 @@ private:
         newThread.wait();
     }
 
+    QCoro::Task<> testMoveToNotYetStartedThread_coro(QCoro::TestContext) {
+        QThread newThread;
+        QTimer::singleShot(100ms, &newThread, [&newThread]() { newThread.start(); });
+
+        // The coroutine is queued until the thread starts its event loop
+        co_await QCoro::moveToThread(&newThread);
+        QCORO_COMPARE(QThread::currentThread(), &newThread);
+
+        co_await QCoro::moveToThread(qApp->thread());
+        QCORO_COMPARE(QThread::currentThread(), QCoreApplication::instance()->thread());
+
+        newThread.exit();
+        newThread.wait();
+    }
+
 private Q_SLOTS:
     addTest(WaitForStarted)
     addTest(WaitForFinished)
     addTest(MoveToThread)
+    addTest(MoveToNotYetStartedThread)
+
+    void benchmarkPingPong() {
+        const int hops = benchmarkSize(1'000, 1'000'000);
+
+        QThread otherThread;
+        otherThread.start();
+        const auto threadGuard = qScopeGuard([&]() {
+            otherThread.exit();
+            otherThread.wait();
+        });
+
+        int count = 0;
+        const auto pingPong = [&]() -> QCoro::Task<> {
+            for (int i = 0; i < hops; ++i) {
+                co_await QCoro::moveToThread(&otherThread);
+                co_await QCoro::moveToThread(qApp->thread());
+                ++count;
+            }
+        };
+
+        QBENCHMARK_ONCE {
+            QCoro::waitFor(pingPong());
+        }
+        QCOMPARE(count, hops);
+    }
 };
 
 
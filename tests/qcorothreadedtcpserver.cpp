@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcoro/network/qcoroabstractsocket.h"
+#include "qcoro/network/qcorothreadedtcpserver.h"
+#include "qcorotimer.h"
+
+#include <QTcpSocket>
+#include <QThread>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class QCoroThreadedTcpServerTest : public QCoro::TestObject<QCoroThreadedTcpServerTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testServesConnectionsOnWorkers_coro(QCoro::TestContext) {
+        std::mutex mutex;
+        std::set<QThread *> handlerThreads;
+
+        QCoro::ThreadedTcpServer server([&](QTcpSocket *socket) -> QCoro::Task<> {
+            {
+                std::lock_guard lock{mutex};
+                handlerThreads.insert(QThread::currentThread());
+            }
+            const auto line = co_await qCoro(socket).readLine();
+            co_await qCoro(socket).write(line.toUpper());
+            socket->disconnectFromHost();
+            if (socket->state() != QAbstractSocket::UnconnectedState) {
+                co_await qCoro(socket).waitForDisconnected(10s);
+            }
+        }, 2);
+        QCORO_COMPARE(server.workerCount(), 2);
+        QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+
+        std::vector<std::unique_ptr<QTcpSocket>> clients;
+        for (int i = 0; i < 4; ++i) {
+            auto &client = clients.emplace_back(std::make_unique<QTcpSocket>());
+            QCORO_VERIFY(co_await qCoro(client.get()).connectToHost(QHostAddress::LocalHost, server.serverPort()));
+            client->write("ping " + QByteArray::number(i) + '\n');
+        }
+
+        for (int i = 0; i < 4; ++i) {
+            const auto response = co_await qCoro(clients[i].get()).readAll();
+            QCORO_COMPARE(response, "PING " + QByteArray::number(i) + '\n');
+        }
+
+        std::lock_guard lock{mutex};
+        // Connections have been distributed round-robin to both workers, neither of them
+        // being the thread that accepted them
+        QCORO_COMPARE(handlerThreads.size(), std::size_t{2});
+        QCORO_VERIFY(!handlerThreads.contains(QThread::currentThread()));
+    }
+
+    QCoro::Task<> testClosesOpenConnectionsOnDestruction_coro(QCoro::TestContext) {
+        QTcpSocket client;
+        std::atomic<bool> handlerFinished = false;
+        {
+            QCoro::ThreadedTcpServer server([&handlerFinished](QTcpSocket *socket) -> QCoro::Task<> {
+                // Only finishes once the server aborts the connection, the client doesn't send anything
+                co_await qCoro(socket).readAll();
+                handlerFinished = true;
+            }, 1);
+            QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+            QCORO_VERIFY(co_await qCoro(client).connectToHost(QHostAddress::LocalHost, server.serverPort()));
+            // Let the worker pick up the connection
+            co_await QCoro::sleepFor(100ms);
+        }
+
+        // The server has waited for the handler
+        QCORO_VERIFY(handlerFinished);
+        QCORO_VERIFY(co_await qCoro(client).waitForDisconnected(10s));
+    }
+
+private Q_SLOTS:
+    addTest(ServesConnectionsOnWorkers)
+    addTest(ClosesOpenConnectionsOnDestruction)
+};
+
+QTEST_GUILESS_MAIN(QCoroThreadedTcpServerTest)
+
+#include "qcorothreadedtcpserver.moc"
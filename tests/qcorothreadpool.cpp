@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+#include "qcoro/core/qcorothreadpool.h"
+
+#include <QCoreApplication>
+#include <QThread>
+
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+QCoro::Task<int> computeOnPool(QCoro::ThreadPool &pool, QCoro::Executor &origin, int value,
+                               std::mutex &mutex, std::set<std::thread::id> &threads) {
+    co_await pool.schedule();
+    {
+        std::lock_guard lock(mutex);
+        threads.insert(std::this_thread::get_id());
+    }
+    const int result = value * value;
+    co_await origin.schedule();
+    co_return result;
+}
+
+QCoro::Task<> hopThroughPool(QCoro::ThreadPool &pool, QCoro::Executor &origin, int &counter) {
+    co_await pool.schedule();
+    co_await origin.schedule();
+    ++counter;
+}
+
+} // namespace
+
+class QCoroThreadPoolTest : public QCoro::TestObject<QCoroThreadPoolTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testScheduleAndReturn_coro(QCoro::TestContext) {
+        QCoro::ThreadPool pool(2);
+        QCORO_COMPARE(pool.threadCount(), std::size_t{2});
+        QCORO_VERIFY(!pool.isWorkerThread());
+
+        auto &origin = QCoro::ThreadExecutor::current();
+        co_await pool.schedule();
+        QCORO_VERIFY(pool.isWorkerThread());
+        QCORO_VERIFY(QThread::currentThread() != QCoreApplication::instance()->thread());
+
+        co_await origin.schedule();
+        QCORO_VERIFY(!pool.isWorkerThread());
+        QCORO_COMPARE(QThread::currentThread(), QCoreApplication::instance()->thread());
+    }
+
+    QCoro::Task<> testParallelWork_coro(QCoro::TestContext) {
+        QCoro::ThreadPool pool(4);
+        auto &origin = QCoro::ThreadExecutor::current();
+        std::mutex mutex;
+        std::set<std::thread::id> threads;
+
+        std::vector<QCoro::Task<int>> tasks;
+        for (int i = 0; i < 1000; ++i) {
+            tasks.push_back(computeOnPool(pool, origin, i, mutex, threads));
+        }
+        const auto results = co_await QCoro::whenAll(std::move(tasks));
+
+        QCORO_COMPARE(results.size(), std::size_t{1000});
+        for (int i = 0; i < 1000; ++i) {
+            QCORO_COMPARE(results[i], i * i);
+        }
+        QCORO_VERIFY(!threads.empty());
+        QCORO_VERIFY(threads.size() <= pool.threadCount());
+        QCORO_VERIFY(!threads.contains(std::this_thread::get_id()));
+    }
+
+    QCoro::Task<> testDefaultThreadCount_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+
+        QCoro::ThreadPool pool;
+        QCORO_COMPARE(pool.threadCount(), std::max<std::size_t>(std::thread::hardware_concurrency(), 1));
+    }
+
+private Q_SLOTS:
+    addTest(ScheduleAndReturn)
+    addTest(ParallelWork)
+    addTest(DefaultThreadCount)
+
+    void benchmarkHopToPoolAndBack() {
+        QCoro::ThreadPool pool;
+        auto &origin = QCoro::ThreadExecutor::current();
+        constexpr int hops = 1000;
+        int counter = 0;
+        QBENCHMARK {
+            counter = 0;
+            std::vector<QCoro::Task<>> tasks;
+            tasks.reserve(hops);
+            for (int i = 0; i < hops; ++i) {
+                tasks.push_back(hopThroughPool(pool, origin, counter));
+            }
+            while (counter < hops) {
+                QCoreApplication::processEvents();
+            }
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(QCoroThreadPoolTest)
+
+#include "qcorothreadpool.moc"
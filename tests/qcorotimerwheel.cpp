@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+
+#include "qcoro/core/qcorosignal.h"
+#include "qcoro/core/qcorotimer.h"
+#include "qcoro/impl/timerwheel.h"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class Emitter : public QObject {
+    Q_OBJECT
+
+Q_SIGNALS:
+    void ping();
+};
+
+namespace {
+
+using QCoro::detail::TimerEntry;
+using QCoro::detail::TimerWheel;
+
+//! Records the order in which the entries expire.
+struct RecordingEntry : TimerEntry {
+    RecordingEntry(int id, std::vector<int> &expired)
+        : id(id)
+        , expired(&expired)
+    {
+        callback = [](TimerEntry *entry) {
+            auto *self = static_cast<RecordingEntry *>(entry);
+            self->expired->push_back(self->id);
+        };
+    }
+
+    int id;
+    std::vector<int> *expired;
+};
+
+} // namespace
+
+class QCoroTimerWheelTest : public QCoro::TestObject<QCoroTimerWheelTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testManySignalTimeouts_coro(QCoro::TestContext) {
+        constexpr int awaiterCount = 10'000;
+        Emitter emitter;
+        const auto awaitPing = [](Emitter *emitter) -> QCoro::Task<bool> {
+            const auto result = co_await qCoro(emitter, &Emitter::ping, 50ms);
+            co_return result.has_value();
+        };
+
+        std::vector<QCoro::Task<bool>> awaiters;
+        awaiters.reserve(awaiterCount);
+        for (int i = 0; i < awaiterCount; ++i) {
+            awaiters.push_back(awaitPing(&emitter));
+        }
+        QCORO_COMPARE(TimerWheel::current().size(), std::size_t{awaiterCount});
+
+        const auto results = co_await QCoro::whenAll(awaiters);
+        QCORO_VERIFY(std::none_of(results.begin(), results.end(), [](bool emitted) { return emitted; }));
+        QCORO_COMPARE(TimerWheel::current().size(), std::size_t{0});
+    }
+
+    QCoro::Task<> testSleepForUsesWheel_coro(QCoro::TestContext) {
+        QElapsedTimer elapsed;
+        elapsed.start();
+        auto sleeper = QCoro::sleepFor(50ms);
+        QCORO_COMPARE(TimerWheel::current().size(), std::size_t{1});
+        co_await sleeper;
+        QCORO_VERIFY(elapsed.elapsed() >= 50);
+        QCORO_COMPARE(TimerWheel::current().size(), std::size_t{0});
+    }
+
+    QCoro::Task<> testSleepUntilPast_coro(QCoro::TestContext) {
+        // Still yields to the event loop, just like a zero-length sleep
+        co_await QCoro::sleepUntil(std::chrono::steady_clock::now() - 1s);
+    }
+
+    QCoro::Task<> testSleepForZero_coro(QCoro::TestContext) {
+        co_await QCoro::sleepFor(0ms);
+    }
+
+private Q_SLOTS:
+    void testExpiresInOrder() {
+        std::vector<int> expired;
+        RecordingEntry slow(3, expired);
+        RecordingEntry fast(1, expired);
+        RecordingEntry medium(2, expired);
+        auto &wheel = TimerWheel::current();
+        wheel.add(slow, 90ms);
+        wheel.add(fast, 10ms);
+        wheel.add(medium, 50ms);
+        QCOMPARE(wheel.size(), std::size_t{3});
+
+        QTRY_COMPARE(expired.size(), std::size_t{3});
+        QCOMPARE(expired, (std::vector<int>{1, 2, 3}));
+        QCOMPARE(wheel.size(), std::size_t{0});
+        QVERIFY(!slow.isScheduled());
+    }
+
+    void testCancel() {
+        std::vector<int> expired;
+        RecordingEntry cancelled(1, expired);
+        RecordingEntry kept(2, expired);
+        auto &wheel = TimerWheel::current();
+        wheel.add(cancelled, 10ms);
+        wheel.add(kept, 30ms);
+        {
+            // Destroying a scheduled entry cancels it as well
+            RecordingEntry destroyed(3, expired);
+            wheel.add(destroyed, 10ms);
+        }
+        cancelled.cancel();
+        QVERIFY(!cancelled.isScheduled());
+        QCOMPARE(wheel.size(), std::size_t{1});
+
+        QTRY_COMPARE(expired, (std::vector<int>{2}));
+        QTest::qWait(20);
+        QCOMPARE(expired, (std::vector<int>{2}));
+    }
+
+    void testCallbackSchedulesEntry() {
+        std::vector<int> expired;
+        struct ChainedEntry : RecordingEntry {
+            ChainedEntry(std::vector<int> &expired, RecordingEntry &next)
+                : RecordingEntry(1, expired)
+                , next(&next)
+            {
+                callback = [](TimerEntry *entry) {
+                    auto *self = static_cast<ChainedEntry *>(entry);
+                    self->expired->push_back(self->id);
+                    TimerWheel::current().add(*self->next, 10ms);
+                };
+            }
+
+            RecordingEntry *next;
+        };
+        RecordingEntry second(2, expired);
+        ChainedEntry first(expired, second);
+        TimerWheel::current().add(first, 10ms);
+
+        QTRY_COMPARE(expired, (std::vector<int>{1, 2}));
+    }
+
+    void testLongTimeout() {
+        std::vector<int> expired;
+        RecordingEntry entry(1, expired);
+        auto &wheel = TimerWheel::current();
+        // Far beyond the range of the wheel, must not overflow
+        wheel.add(entry, std::chrono::milliseconds::max());
+        QCOMPARE(wheel.size(), std::size_t{1});
+        entry.cancel();
+        QCOMPARE(wheel.size(), std::size_t{0});
+    }
+
+    addTest(ManySignalTimeouts)
+    addTest(SleepForUsesWheel)
+    addTest(SleepUntilPast)
+    addTest(SleepForZero)
+
+    void benchmarkScheduleAndCancel() {
+        constexpr int entryCount = 10'000;
+        std::vector<int> expired;
+        std::vector<std::unique_ptr<RecordingEntry>> entries;
+        for (int i = 0; i < entryCount; ++i) {
+            entries.push_back(std::make_unique<RecordingEntry>(i, expired));
+        }
+
+        auto &wheel = TimerWheel::current();
+        QBENCHMARK {
+            for (int i = 0; i < entryCount; ++i) {
+                wheel.add(*entries[i], std::chrono::milliseconds{1000 + (i * 7919) % 60'000});
+            }
+            for (auto &entry : entries) {
+                entry->cancel();
+            }
+        }
+        QVERIFY(expired.empty());
+    }
+};
+
+QTEST_GUILESS_MAIN(QCoroTimerWheelTest)
+
+#include "qcorotimerwheel.moc"
@@ -11,6 +11,9 @@
 
 #include <QTest>
 
+#include <memory>
+#include <vector>
+
 class QCoroWebSocketServerTest : public QCoro::TestObject<QCoroWebSocketServerTest> {
     Q_OBJECT
 public:
@@ -124,12 +127,114 @@ private:
         QCORO_VERIFY(serverSocket);
     }
 
+    QCoro::Task<> testConnections_coro(QCoro::TestContext) {
+        QWebSocketServer server(QStringLiteral("TestWSServer"), QWebSocketServer::NonSecureMode);
+        QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+
+        std::vector<std::unique_ptr<QWebSocket>> clients;
+        for (int i = 0; i < 3; ++i) {
+            clients.emplace_back(std::make_unique<QWebSocket>())->open(server.serverUrl());
+        }
+
+        std::vector<std::unique_ptr<QWebSocket>> connections;
+        QCORO_FOREACH(QWebSocket *connection, qCoro(server).connections(10s)) {
+            QCORO_VERIFY(connection != nullptr);
+            connections.emplace_back(connection);
+            if (connections.size() == clients.size()) {
+                break;
+            }
+        }
+        QCORO_COMPARE(connections.size(), clients.size());
+    }
+
+    QCoro::Task<> testConnectionsEndOnTimeout_coro(QCoro::TestContext) {
+        QWebSocketServer server(QStringLiteral("TestWSServer"), QWebSocketServer::NonSecureMode);
+        QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+
+        int count = 0;
+        QCORO_FOREACH(QWebSocket *connection, qCoro(server).connections(100ms)) {
+            Q_UNUSED(connection);
+            ++count;
+        }
+        QCORO_COMPARE(count, 0);
+    }
+
+    QCoro::Task<> testConnectionsEndWhenServerClosed_coro(QCoro::TestContext) {
+        QWebSocketServer server(QStringLiteral("TestWSServer"), QWebSocketServer::NonSecureMode);
+        QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+        QCORO_DELAY(server.close());
+
+        int count = 0;
+        QCORO_FOREACH(QWebSocket *connection, qCoro(server).connections()) {
+            Q_UNUSED(connection);
+            ++count;
+        }
+        QCORO_COMPARE(count, 0);
+    }
+
+    QCoro::Task<> testConnectionsDoesntCoawaitNonlisteningServer_coro(QCoro::TestContext ctx) {
+        ctx.setShouldNotSuspend();
+
+        QWebSocketServer server(QStringLiteral("TestWSServer"), QWebSocketServer::NonSecureMode);
+
+        int count = 0;
+        QCORO_FOREACH(QWebSocket *connection, qCoro(server).connections()) {
+            Q_UNUSED(connection);
+            ++count;
+        }
+        QCORO_COMPARE(count, 0);
+    }
+
+    static QCoro::Task<> acceptConnections(QWebSocketServer &server, std::size_t count, bool useConnections) {
+        std::vector<std::unique_ptr<QWebSocket>> connections;
+        if (useConnections) {
+            QCORO_FOREACH(QWebSocket *connection, qCoro(server).connections()) {
+                connections.emplace_back(connection);
+                if (connections.size() == count) {
+                    break;
+                }
+            }
+        } else {
+            while (connections.size() < count) {
+                connections.emplace_back(co_await qCoro(server).nextPendingConnection());
+            }
+        }
+    }
+
 private Q_SLOTS:
     addCoroAndThenTests(NextPendingConnection)
     addCoroAndThenTests(NextPendingConnectionTimeout)
     addCoroAndThenTests(ClosingServerResumesAwaiters)
     addTest(DoesntCoawaitNonlisteningServer)
     addTest(DoesntCoawaitWithPendingConnection)
+    addTest(Connections)
+    addTest(ConnectionsEndOnTimeout)
+    addTest(ConnectionsEndWhenServerClosed)
+    addTest(ConnectionsDoesntCoawaitNonlisteningServer)
+
+    void benchmarkAcceptConnections_data() {
+        QTest::addColumn<bool>("useConnections");
+        QTest::newRow("connections") << true;
+        QTest::newRow("nextPendingConnection") << false;
+    }
+
+    // Accepting a storm of simultaneous handshakes
+    void benchmarkAcceptConnections() {
+        QFETCH(bool, useConnections);
+        constexpr std::size_t clientCount = 200;
+
+        QWebSocketServer server(QStringLiteral("TestWSServer"), QWebSocketServer::NonSecureMode);
+        server.setMaxPendingConnections(clientCount);
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+
+        QBENCHMARK {
+            std::vector<std::unique_ptr<QWebSocket>> clients;
+            for (std::size_t i = 0; i < clientCount; ++i) {
+                clients.emplace_back(std::make_unique<QWebSocket>())->open(server.serverUrl());
+            }
+            QCoro::waitFor(acceptConnections(server, clientCount, useConnections));
+        }
+    }
 };
 
 QTEST_GUILESS_MAIN(QCoroWebSocketServerTest)
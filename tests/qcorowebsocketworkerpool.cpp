@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "websockets/qcorowebsocket.h"
+#include "websockets/qcorowebsocketserver.h"
+#include "websockets/qcorowebsocketworkerpool.h"
+#include "testobject.h"
+#include "qcorosignal.h"
+#include "qcorotimer.h"
+
+#include <QThread>
+#include <QWebSocket>
+#include <QWebSocketServer>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace {
+
+//! Greets the client, echoes its first message and keeps the connection until the client closes it.
+/*!
+ * The handler speaks first, so that the client's message cannot arrive before the handler
+ * listens for it.
+ */
+QCoro::Task<> echoOnce(QWebSocket *socket) {
+    auto messages = qCoro(socket).textMessages(10s);
+    socket->sendTextMessage(QStringLiteral("hello"));
+    auto it = co_await messages.begin();
+    if (it != messages.end()) {
+        socket->sendTextMessage(*it);
+        co_await ++it;
+    }
+}
+
+} // namespace
+
+class QCoroWebSocketWorkerPoolTest : public QCoro::TestObject<QCoroWebSocketWorkerPoolTest> {
+    Q_OBJECT
+public:
+    explicit QCoroWebSocketWorkerPoolTest(QObject *parent = nullptr)
+        : QCoro::TestObject<QCoroWebSocketWorkerPoolTest>(parent)
+    {
+        // On Windows, constructing QWebSocket for the first time takes some time
+        // (most likely due to loading OpenSSL), which causes the first test to
+        // time out on the CI.
+        QWebSocket socket;
+    }
+
+private:
+    static QCoro::Task<> dispatchConnections(QWebSocketServer &server, QCoro::WebSocketWorkerPool &workers) {
+        QCORO_FOREACH(QWebSocket *socket, qCoro(server).connections()) {
+            workers.dispatch(socket);
+        }
+    }
+
+    //! Opens \c clientCount connections at once, each sends a message once greeted by the server.
+    /*!
+     * Returns the number of clients whose message has been echoed back.
+     */
+    static QCoro::Task<int> runClients(const QUrl &url, int clientCount) {
+        int echoed = 0;
+        std::vector<std::unique_ptr<QWebSocket>> clients;
+        for (int i = 0; i < clientCount; ++i) {
+            auto *client = clients.emplace_back(std::make_unique<QWebSocket>()).get();
+            const auto ping = QStringLiteral("ping %1").arg(i);
+            QObject::connect(client, &QWebSocket::textMessageReceived, client,
+                             [client, ping, &echoed](const QString &message) {
+                if (message == QLatin1String("hello")) {
+                    client->sendTextMessage(ping);
+                } else if (message == ping) {
+                    ++echoed;
+                    client->close();
+                }
+            });
+            client->open(url);
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + 30s;
+        while (echoed < clientCount && std::chrono::steady_clock::now() < deadline) {
+            co_await QCoro::sleepFor(10ms);
+        }
+        co_return echoed;
+    }
+
+    QCoro::Task<> testServesConnectionsOnWorkers_coro(QCoro::TestContext) {
+        std::mutex mutex;
+        std::set<QThread *> handlerThreads;
+        QCoro::WebSocketWorkerPool workers([&](QWebSocket *socket) -> QCoro::Task<> {
+            {
+                std::lock_guard lock{mutex};
+                handlerThreads.insert(QThread::currentThread());
+            }
+            co_await echoOnce(socket);
+        }, 2);
+        QCORO_COMPARE(workers.workerCount(), 2);
+
+        QWebSocketServer server(QStringLiteral("TestWSServer"), QWebSocketServer::NonSecureMode);
+        QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+        auto dispatcher = dispatchConnections(server, workers);
+
+        const auto echoed = co_await runClients(server.serverUrl(), 4);
+        QCORO_COMPARE(echoed, 4);
+
+        server.close();
+        co_await dispatcher;
+
+        std::lock_guard lock{mutex};
+        // Connections have been distributed round-robin to both workers, neither of them
+        // being the thread that accepted them
+        QCORO_COMPARE(handlerThreads.size(), std::size_t{2});
+        QCORO_VERIFY(!handlerThreads.contains(QThread::currentThread()));
+    }
+
+    // Load test: a storm of simultaneous handshakes, as after all clients reconnect at once
+    QCoro::Task<> testConnectionStorm_coro(QCoro::TestContext) {
+        constexpr int clientCount = 200;
+
+        QCoro::WebSocketWorkerPool workers(echoOnce, 4);
+
+        QWebSocketServer server(QStringLiteral("TestWSServer"), QWebSocketServer::NonSecureMode);
+        server.setMaxPendingConnections(clientCount);
+        QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+        auto dispatcher = dispatchConnections(server, workers);
+
+        const auto echoed = co_await runClients(server.serverUrl(), clientCount);
+        QCORO_COMPARE(echoed, clientCount);
+
+        server.close();
+        co_await dispatcher;
+    }
+
+    QCoro::Task<> testClosesOpenConnectionsOnDestruction_coro(QCoro::TestContext) {
+        QWebSocketServer server(QStringLiteral("TestWSServer"), QWebSocketServer::NonSecureMode);
+        QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+
+        QWebSocket client;
+        std::atomic<bool> handlerFinished = false;
+        {
+            QCoro::WebSocketWorkerPool workers([&handlerFinished](QWebSocket *socket) -> QCoro::Task<> {
+                // Only finishes once the pool aborts the connection, the client doesn't send anything
+                QCORO_FOREACH(const QString &message, qCoro(socket).textMessages()) {
+                    Q_UNUSED(message);
+                }
+                handlerFinished = true;
+            }, 1);
+
+            QCORO_VERIFY(co_await qCoro(client).open(server.serverUrl(), 10s));
+            auto *socket = co_await qCoro(server).nextPendingConnection(10s);
+            QCORO_VERIFY(socket != nullptr);
+            workers.dispatch(socket);
+            // Let the worker pick up the connection
+            co_await QCoro::sleepFor(100ms);
+        }
+
+        // The pool has waited for the handler
+        QCORO_VERIFY(handlerFinished);
+        if (client.state() != QAbstractSocket::UnconnectedState) {
+            const auto disconnected = co_await qCoro(&client, &QWebSocket::disconnected, 10s);
+            QCORO_VERIFY(disconnected.has_value());
+        }
+    }
+
+    QCoro::Task<> testClosesPendingConnectionsOnDestruction_coro(QCoro::TestContext) {
+        QWebSocketServer server(QStringLiteral("TestWSServer"), QWebSocketServer::NonSecureMode);
+        QCORO_VERIFY(server.listen(QHostAddress::LocalHost));
+
+        QWebSocket client;
+        std::atomic<int> handlersFinished = 0;
+        {
+            QCoro::WebSocketWorkerPool workers([&handlersFinished](QWebSocket *socket) -> QCoro::Task<> {
+                QCORO_FOREACH(const QString &message, qCoro(socket).textMessages()) {
+                    Q_UNUSED(message);
+                }
+                ++handlersFinished;
+            }, 1);
+
+            QCORO_VERIFY(co_await qCoro(client).open(server.serverUrl(), 10s));
+            auto *socket = co_await qCoro(server).nextPendingConnection(10s);
+            QCORO_VERIFY(socket != nullptr);
+            // The pool is destroyed before the worker picks up the connection
+            workers.dispatch(socket);
+        }
+
+        // The socket has been served and closed rather than left without an owner
+        QCORO_COMPARE(handlersFinished.load(), 1);
+        if (client.state() != QAbstractSocket::UnconnectedState) {
+            const auto disconnected = co_await qCoro(&client, &QWebSocket::disconnected, 10s);
+            QCORO_VERIFY(disconnected.has_value());
+        }
+    }
+
+private Q_SLOTS:
+    addTest(ServesConnectionsOnWorkers)
+    addTest(ConnectionStorm)
+    addTest(ClosesOpenConnectionsOnDestruction)
+    addTest(ClosesPendingConnectionsOnDestruction)
+};
+
+QTEST_GUILESS_MAIN(QCoroWebSocketWorkerPoolTest)
+
+#include "qcorowebsocketworkerpool.moc"
@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "testobject.h"
+#include "qcorotask.h"
+#include "qcorolazytask.h"
+#include "qcorotimer.h"
+
+#include <QElapsedTimer>
+#include <QTest>
+#include <QTimer>
+
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+template<typename T>
+QCoro::Task<T> delayedValue(T value, std::chrono::milliseconds delay) {
+    co_await QCoro::sleepFor(delay);
+    co_return value;
+}
+
+QCoro::Task<> delayedVoid(std::chrono::milliseconds delay) {
+    co_await QCoro::sleepFor(delay);
+}
+
+QCoro::LazyTask<QString> lazyValue(QString value) {
+    co_await QCoro::sleepFor(10ms);
+    co_return value;
+}
+
+QCoro::Task<int> delayedThrow(std::chrono::milliseconds delay) {
+    co_await QCoro::sleepFor(delay);
+    throw std::runtime_error("Test!");
+    co_return 0;
+}
+
+} // namespace
+
+class QCoroWhenTest : public QCoro::TestObject<QCoroWhenTest> {
+    Q_OBJECT
+
+private:
+    QCoro::Task<> testWhenAll_coro(QCoro::TestContext) {
+        QElapsedTimer elapsed;
+        elapsed.start();
+
+        const auto [number, nothing, string] = co_await QCoro::whenAll(
+            delayedValue(42, 100ms), delayedVoid(100ms), delayedValue(QStringLiteral("Hello"), 100ms));
+
+        static_assert(std::is_same_v<std::remove_cv_t<decltype(nothing)>, std::monostate>);
+        QCORO_COMPARE(number, 42);
+        QCORO_COMPARE(string, QStringLiteral("Hello"));
+        // The awaitables are awaited concurrently
+        QCORO_VERIFY(elapsed.elapsed() < 250);
+    }
+
+    QCoro::Task<> testWhenAllSync_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+
+        const auto ready = []() -> QCoro::Task<int> { co_return 42; };
+        const auto [first, second] = co_await QCoro::whenAll(ready(), ready());
+        QCORO_COMPARE(first, 42);
+        QCORO_COMPARE(second, 42);
+    }
+
+    QCoro::Task<> testWhenAllLvalues_coro(QCoro::TestContext) {
+        auto task = delayedValue(42, 10ms);
+        auto lazyTask = lazyValue(QStringLiteral("Lazy"));
+        QTimer timer;
+        timer.setSingleShot(true);
+        timer.start(10ms);
+
+        const auto [number, string, timeout] = co_await QCoro::whenAll(task, lazyTask, &timer);
+
+        QCORO_COMPARE(number, 42);
+        QCORO_COMPARE(string, QStringLiteral("Lazy"));
+        QCORO_VERIFY(!timer.isActive());
+    }
+
+    QCoro::Task<> testWhenAllRange_coro(QCoro::TestContext) {
+        std::vector<QCoro::Task<int>> tasks;
+        for (int i = 0; i < 10; ++i) {
+            tasks.push_back(delayedValue(i, std::chrono::milliseconds{100 - i * 10}));
+        }
+
+        const auto results = co_await QCoro::whenAll(tasks);
+        // Results are ordered as the tasks, not by the order in which the tasks finished.
+        QCORO_COMPARE(results, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+
+    QCoro::Task<> testWhenAllMovedRange_coro(QCoro::TestContext) {
+        std::vector<QCoro::Task<int>> tasks;
+        for (int i = 0; i < 3; ++i) {
+            tasks.push_back(delayedValue(i, 10ms));
+        }
+
+        auto task = QCoro::whenAll(std::move(tasks));
+        tasks.clear();
+
+        const auto results = co_await task;
+        QCORO_COMPARE(results, (std::vector<int>{0, 1, 2}));
+    }
+
+    QCoro::Task<> testWhenAllVoidRange_coro(QCoro::TestContext) {
+        std::vector<QCoro::Task<>> tasks;
+        tasks.push_back(delayedVoid(10ms));
+        tasks.push_back(delayedVoid(20ms));
+
+        co_await QCoro::whenAll(tasks);
+        for (const auto &task : tasks) {
+            QCORO_VERIFY(task.isReady());
+        }
+    }
+
+    QCoro::Task<> testWhenAllEmptyRange_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+
+        std::vector<QCoro::Task<int>> tasks;
+        const auto results = co_await QCoro::whenAll(tasks);
+        QCORO_VERIFY(results.empty());
+    }
+
+    QCoro::Task<> testWhenAllException_coro(QCoro::TestContext) {
+        auto slowTask = delayedValue(42, 100ms);
+        QCORO_VERIFY_THROWS_EXCEPTION(std::runtime_error,
+                                      co_await QCoro::whenAll(slowTask, delayedThrow(10ms)));
+        // The exception is only rethrown once all the awaitables have finished
+        QCORO_VERIFY(slowTask.isReady());
+    }
+
+    QCoro::Task<> testWhenAny_coro(QCoro::TestContext) {
+        const auto result = co_await QCoro::whenAny(
+            delayedValue(1, 200ms), delayedValue(QStringLiteral("Fast"), 10ms), delayedVoid(200ms));
+
+        QCORO_COMPARE(result.index(), std::size_t{1});
+        QCORO_COMPARE(std::get<1>(result), QStringLiteral("Fast"));
+    }
+
+    QCoro::Task<> testWhenAnyRange_coro(QCoro::TestContext) {
+        std::vector<QCoro::Task<int>> tasks;
+        for (int i = 0; i < 5; ++i) {
+            tasks.push_back(delayedValue(i * 10, std::chrono::milliseconds{100 - i * 20}));
+        }
+
+        const auto [index, value] = co_await QCoro::whenAny(tasks);
+        QCORO_COMPARE(index, std::size_t{4});
+        QCORO_COMPARE(value, 40);
+
+        // The remaining tasks keep running
+        co_await QCoro::whenAll(tasks);
+    }
+
+    QCoro::Task<> testWhenAnyException_coro(QCoro::TestContext) {
+        QCORO_VERIFY_THROWS_EXCEPTION(std::runtime_error,
+                                      co_await QCoro::whenAny(delayedValue(42, 100ms), delayedThrow(10ms)));
+    }
+
+    QCoro::Task<> testWhenAnyEmptyRange_coro(QCoro::TestContext context) {
+        context.setShouldNotSuspend();
+
+        std::vector<QCoro::Task<int>> tasks;
+        QCORO_VERIFY_THROWS_EXCEPTION(std::invalid_argument, co_await QCoro::whenAny(tasks));
+    }
+
+private Q_SLOTS:
+    addTest(WhenAll)
+    addTest(WhenAllSync)
+    addTest(WhenAllLvalues)
+    addTest(WhenAllRange)
+    addTest(WhenAllMovedRange)
+    addTest(WhenAllVoidRange)
+    addTest(WhenAllEmptyRange)
+    addTest(WhenAllException)
+    addTest(WhenAny)
+    addTest(WhenAnyRange)
+    addTest(WhenAnyException)
+    addTest(WhenAnyEmptyRange)
+};
+
+QTEST_GUILESS_MAIN(QCoroWhenTest)
+
+#include "qcorowhen.moc"
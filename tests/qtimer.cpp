@@ -86,6 +86,35 @@ private:
         QCORO_VERIFY(elapsed.elapsed() >= 475);
     }
 
+    QCoro::Task<> testSleepForNotCancelled_coro(QCoro::TestContext) {
+        QCoro::CancellationSource source;
+        const bool slept = co_await QCoro::sleepFor(10ms, source.token());
+        QCORO_VERIFY(slept);
+    }
+
+    QCoro::Task<> testSleepForCancelled_coro(QCoro::TestContext) {
+        QCoro::CancellationSource source;
+        QTimer::singleShot(10ms, [&source]() { source.requestCancellation(); });
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+        const bool slept = co_await QCoro::sleepFor(10s, source.token());
+        QCORO_VERIFY(!slept);
+        QCORO_VERIFY(elapsed.elapsed() < 5000);
+    }
+
+    QCoro::Task<> testCancellationStopsTimer_coro(QCoro::TestContext) {
+        QTimer timer;
+        timer.setSingleShot(true);
+        timer.start(10s);
+
+        QCoro::CancellationSource source;
+        source.requestCancellation();
+        const bool timedOut = co_await qCoro(timer).waitForTimeout(source.token());
+        QCORO_VERIFY(!timedOut);
+        QCORO_VERIFY(!timer.isActive());
+    }
+
 private Q_SLOTS:
     addTest(Triggers)
     addTest(QCoroWrapperTriggers)
@@ -94,6 +123,9 @@ private Q_SLOTS:
     addTest(DoesntCoAwaitNullTimer)
     addTest(SleepFor)
     addTest(SleepUntil)
+    addTest(SleepForNotCancelled)
+    addTest(SleepForCancelled)
+    addTest(CancellationStopsTimer)
 
     addThenTest(Triggers)
 };
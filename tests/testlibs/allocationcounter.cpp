@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "allocationcounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local std::size_t allocationCount = 0;
+thread_local std::size_t deallocationCount = 0;
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    ++allocationCount;
+    if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void *ptr) noexcept {
+    if (ptr) {
+        ++deallocationCount;
+        std::free(ptr);
+    }
+}
+
+void operator delete[](void *ptr) noexcept {
+    ::operator delete(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    ::operator delete(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+    ::operator delete(ptr);
+}
+
+AllocationCounter::AllocationCounter()
+    : mAllocationsOffset(allocationCount)
+    , mDeallocationsOffset(deallocationCount)
+{}
+
+AllocationCounter::~AllocationCounter() = default;
+
+std::size_t AllocationCounter::allocations() const {
+    return allocationCount - mAllocationsOffset;
+}
+
+std::size_t AllocationCounter::deallocations() const {
+    return deallocationCount - mDeallocationsOffset;
+}
@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+
+//! Counts heap allocations made by the current thread while the object is alive.
+/*!
+ * Only works in tests that link the qcoro_test_allocationcounter library, which
+ * replaces the global operator new and operator delete.
+ */
+class AllocationCounter {
+public:
+    explicit AllocationCounter();
+    ~AllocationCounter();
+    AllocationCounter(const AllocationCounter &) = delete;
+    AllocationCounter &operator=(const AllocationCounter &) = delete;
+
+    //! Number of allocations made since the counter was constructed.
+    std::size_t allocations() const;
+    //! Number of deallocations made since the counter was constructed.
+    std::size_t deallocations() const;
+
+private:
+    std::size_t mAllocationsOffset = 0;
+    std::size_t mDeallocationsOffset = 0;
+};
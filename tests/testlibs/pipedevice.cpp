@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#include "pipedevice.h"
+
+#include <algorithm>
+
+PipeDevice::PipeDevice(QIODevice::OpenMode mode) {
+    open(mode);
+}
+
+bool PipeDevice::isSequential() const {
+    return true;
+}
+
+qint64 PipeDevice::bytesAvailable() const {
+    return mData.size() + QIODevice::bytesAvailable();
+}
+
+void PipeDevice::feed(const QByteArray &data) {
+    mData += data;
+    Q_EMIT readyRead();
+}
+
+void PipeDevice::finish() {
+    Q_EMIT readChannelFinished();
+}
+
+qint64 PipeDevice::readData(char *data, qint64 maxSize) {
+    const auto size = std::min<qint64>(maxSize, mData.size());
+    std::copy_n(mData.constData(), size, data);
+    mData.remove(0, size);
+    return size;
+}
+
+qint64 PipeDevice::writeData(const char *data, qint64 size) {
+    written.append(data, size);
+    ++writeCount;
+    return size;
+}
@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2026 Daniel Vrátil <dvratil@kde.org>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QByteArray>
+#include <QIODevice>
+
+//! Sequential device whose incoming data are fed by the test.
+/*!
+ * When opened for writing, the data written to the device are recorded.
+ */
+class PipeDevice : public QIODevice {
+    Q_OBJECT
+public:
+    explicit PipeDevice(QIODevice::OpenMode mode = QIODevice::ReadOnly);
+
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+
+    //! Makes the \c data available for reading.
+    void feed(const QByteArray &data);
+    //! Signals that no more data will be fed.
+    void finish();
+
+    //! Data written to the device.
+    QByteArray written;
+    //! Number of writes to the device.
+    int writeCount = 0;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 size) override;
+
+private:
+    QByteArray mData;
+};
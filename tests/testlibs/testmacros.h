@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <QtGlobal>
+
 //! Executes given \c expr with 10ms delay.
 #define QCORO_DELAY(expr)                                                                          \
     QTimer::singleShot(10ms, [&]() { expr; })
@@ -16,4 +18,13 @@
     QCORO_VERIFY((end - start) < 500ms); \
 }
 
-
+//! Returns \c full if the QCORO_FULL_BENCHMARKS environment variable is set, \c reduced otherwise.
+/*!
+ * Benchmarks run as part of the regular test suite, so by default the expensive ones only do
+ * a fraction of the work they are meant to measure. Set QCORO_FULL_BENCHMARKS=1 to run them
+ * at full size.
+ */
+template<typename T>
+inline T benchmarkSize(T reduced, T full) {
+    return qEnvironmentVariableIsSet("QCORO_FULL_BENCHMARKS") ? full : reduced;
+}